@@ -2,7 +2,9 @@
 #include <iostream>
 #include <fstream>
 #include <random>
+#include <algorithm>
 #include "../game/Game.h"
+#include "../game/MoveList.h"
 #include "../stats/MoveStats.h"
 #include "../stats/GameStats.h"
 #include "../stats/SimulationStats.h"
@@ -13,7 +15,7 @@ class AIPlayer
 {
 protected:
     mt19937 gen;
-    vector<int> possibleMoves;
+    MoveList possibleMoves;
 
     string playerName;
 
@@ -36,6 +38,7 @@ public:
     int getRandomMove();
 
     virtual int chooseMove(const Game &game) = 0;
+    virtual void clearSearchState();
 
     void clearMoveStats();
     void resetStats();
@@ -65,11 +68,19 @@ void AIPlayer::clearMoveStats()
     allMovesStats.clear();
 }
 
+// Koniec partii: statystyki idą do historii, a stan przeszukiwania
+// z tej partii (tablice, historia, drzewo) jest czyszczony.
 void AIPlayer::resetStats()
 {
     GameStats gameStats = GameStats(getAllMovesStats());
     allGamesStats.push_back(gameStats);
     clearMoveStats();
+    clearSearchState();
+}
+
+// Gracze bez stanu między ruchami nie mają czego czyścić.
+void AIPlayer::clearSearchState()
+{
 }
 
 void AIPlayer::saveGamesStats() const
@@ -108,6 +119,166 @@ void AIPlayer::saveGamesStats() const
                 file << moveStats.timeTaken.count() / 1000.0 << ";";
             }
 
+            bool iterative = any_of(gameStats.moves.begin(), gameStats.moves.end(),
+                                    [](const MoveStats &m)
+                                    { return m.depthReached > 0; });
+            if (iterative)
+            {
+                file << "\nDepth reached;";
+                for (MoveStats moveStats : gameStats.moves)
+                {
+                    file << moveStats.depthReached << ";";
+                }
+            }
+
+            bool ordered = any_of(gameStats.moves.begin(), gameStats.moves.end(),
+                                  [](const MoveStats &m)
+                                  { return m.firstMoveCutoffs > 0; });
+            if (ordered)
+            {
+                file << "\nFirst-move cutoff rate;";
+                for (MoveStats moveStats : gameStats.moves)
+                {
+                    file << moveStats.firstMoveCutoffRate() << ";";
+                }
+            }
+
+            bool researched = any_of(gameStats.moves.begin(), gameStats.moves.end(),
+                                     [](const MoveStats &m)
+                                     { return m.pvsResearches > 0 || m.aspirationResearches > 0; });
+            if (researched)
+            {
+                file << "\nPVS re-searches;";
+                for (MoveStats moveStats : gameStats.moves)
+                {
+                    file << moveStats.pvsResearches << ";";
+                }
+                file << "\nAspiration re-searches;";
+                for (MoveStats moveStats : gameStats.moves)
+                {
+                    file << moveStats.aspirationResearches << ";";
+                }
+            }
+
+            bool parallel = any_of(gameStats.moves.begin(), gameStats.moves.end(),
+                                   [](const MoveStats &m)
+                                   { return m.parallelSpeedup > 0; });
+            if (parallel)
+            {
+                file << "\nParallel speedup;";
+                for (MoveStats moveStats : gameStats.moves)
+                {
+                    file << moveStats.parallelSpeedup << ";";
+                }
+            }
+
+            bool workStealing = any_of(gameStats.moves.begin(), gameStats.moves.end(),
+                                       [](const MoveStats &m)
+                                       { return m.steals > 0 || m.idleTime.count() > 0; });
+            if (workStealing)
+            {
+                file << "\nSteals;";
+                for (MoveStats moveStats : gameStats.moves)
+                {
+                    file << moveStats.steals << ";";
+                }
+                file << "\nIdle time [ms];";
+                for (MoveStats moveStats : gameStats.moves)
+                {
+                    file << moveStats.idleTime.count() / 1000.0 << ";";
+                }
+            }
+
+            bool playouts = any_of(gameStats.moves.begin(), gameStats.moves.end(),
+                                   [](const MoveStats &m)
+                                   { return m.playoutsPerSecond > 0; });
+            if (playouts)
+            {
+                file << "\nPlayouts/s;";
+                for (MoveStats moveStats : gameStats.moves)
+                {
+                    file << moveStats.playoutsPerSecond << ";";
+                }
+                file << "\nTree nodes;";
+                for (MoveStats moveStats : gameStats.moves)
+                {
+                    file << moveStats.treeNodes << ";";
+                }
+            }
+
+            bool booked = any_of(gameStats.moves.begin(), gameStats.moves.end(),
+                                 [](const MoveStats &m)
+                                 { return m.fromBook; });
+            if (booked)
+            {
+                file << "\nFrom book;";
+                for (MoveStats moveStats : gameStats.moves)
+                {
+                    file << moveStats.fromBook << ";";
+                }
+            }
+
+            bool solved = any_of(gameStats.moves.begin(), gameStats.moves.end(),
+                                 [](const MoveStats &m)
+                                 { return m.solved; });
+            if (solved)
+            {
+                file << "\nSolved;";
+                for (MoveStats moveStats : gameStats.moves)
+                {
+                    file << moveStats.solved << ";";
+                }
+                file << "\nExact score;";
+                for (MoveStats moveStats : gameStats.moves)
+                {
+                    file << moveStats.evalScore << ";";
+                }
+                file << "\nPlies to end;";
+                for (MoveStats moveStats : gameStats.moves)
+                {
+                    file << moveStats.pliesToEnd << ";";
+                }
+                file << "\nSolve time [ms];";
+                for (MoveStats moveStats : gameStats.moves)
+                {
+                    file << moveStats.solveTime.count() / 1000.0 << ";";
+                }
+            }
+
+            bool usedTable = any_of(gameStats.moves.begin(), gameStats.moves.end(),
+                                    [](const MoveStats &m)
+                                    { return m.ttProbes > 0; });
+            if (usedTable)
+            {
+                file << "\nTT probes;";
+                for (MoveStats moveStats : gameStats.moves)
+                {
+                    file << moveStats.ttProbes << ";";
+                }
+                file << "\nTT hits;";
+                for (MoveStats moveStats : gameStats.moves)
+                {
+                    file << moveStats.ttHits << ";";
+                }
+                file << "\nTT cutoffs;";
+                for (MoveStats moveStats : gameStats.moves)
+                {
+                    file << moveStats.ttCutoffs << ";";
+                }
+            }
+
+            bool reused = any_of(gameStats.moves.begin(), gameStats.moves.end(),
+                                 [](const MoveStats &m)
+                                 { return m.reusedFraction > 0; });
+            if (reused)
+            {
+                file << "\nReused work;";
+                for (MoveStats moveStats : gameStats.moves)
+                {
+                    file << moveStats.reusedFraction << ";";
+                }
+            }
+
             i++;
             file << "\n\n\n";
         }
@@ -165,6 +336,17 @@ void AIPlayer::printStatsSummary() const
 {
     printf("\n=== STATYSTYKI %s ===\n", getName().c_str());
     printf("Liczba ruchów: %zu\n", allMovesStats.size());
+
+    int solvedMoves = 0;
+    chrono::microseconds solveTime(0);
+    for (const MoveStats &stats : allMovesStats)
+    {
+        solvedMoves += stats.solved;
+        solveTime += stats.solveTime;
+    }
+    if (solvedMoves > 0)
+        printf("Ruchy rozstrzygnięte dokładnie: %d, czas solvera: %.1f ms\n",
+               solvedMoves, solveTime.count() / 1000.0);
 }
 
 string AIPlayer::getName() const
@@ -182,7 +364,7 @@ int AIPlayer::getRandomMove()
 
 void AIPlayer::addPosibleMove(int move)
 {
-    possibleMoves.push_back(move);
+    possibleMoves.add(move);
 }
 
 void AIPlayer::clearPossibleMoves()
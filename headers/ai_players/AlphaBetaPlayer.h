@@ -5,26 +5,93 @@
 #include "AIPlayer.h"
 #include "../game/Game.h"
 #include "../stats/MoveStats.h"
+#include "../search/TranspositionTable.h"
+#include "../search/SearchLimits.h"
+#include "../search/MoveOrdering.h"
+#include "../search/SearchThread.h"
+#include "../search/Search.h"
+#include "../search/OpeningBook.h"
+#include "../search/Solver.h"
 
 using namespace std;
 
+// Przeszukiwanie alfa-beta (negamax) z iteracyjnym pogłębianiem. Przy więcej
+// niż jednym wątku działa jako Lazy SMP: wątki pomocnicze przeszukują ten sam
+// korzeń z przesuniętą głębokością i inną kolejnością ruchów w korzeniu,
+// a dzielą się wynikami wyłącznie przez wspólną tablicę transpozycji.
+//
+// Domyślnie działa jako PVS (NegaScout): pełne okno tylko dla pierwszego
+// ruchu, pozostałe sprawdzane zerowym oknem i przeszukiwane ponownie, gdy
+// okażą się lepsze. Iteracje od drugiej zaczynają od okna aspiracyjnego
+// wokół wyniku poprzedniej i poszerzają je po wyjściu wyniku poza okno.
+//
+// Samo przeszukiwanie jest w Search<GameT>; gracz trzyma stan między
+// ruchami i wybiera wersję rdzenia dla konkretnego typu gry. Z ustawioną
+// księgą otwarć pozycje z księgi nie są w ogóle przeszukiwane.
+//
+// Po setEndgameThreshold w końcówce (najwyżej tyle pustych pól) ruch
+// wybiera Solver: bez oceny heurystycznej, tylko wygrana / remis /
+// przegrana, co przy kilkunastu wolnych polach kończy się szybciej niż
+// przeszukiwanie z oceną. Przy budżecie solver dostaje jego połowę, a gdy
+// nie zdąży, zwykłe szukanie dostaje to, co zostało. Domyślnie wyłączone,
+// żeby gracz o stałej głębokości grał tak samo w całej partii.
+//
+// Tryb pomiarowy (setSpeedupBenchmark) mierzy przyspieszenie Lazy SMP:
+// po każdym ruchu ta sama pozycja jest przeszukiwana jednym wątkiem do
+// osiągniętej głębokości i porównywany jest czas dojścia do niej. Obie
+// wersje zaczynają od pustej tablicy, więc w tym trybie nic nie przechodzi
+// między ruchami, a ruch trwa dłużej o przebieg wzorcowy.
 class AlphaBetaPlayer : public AIPlayer
 {
 private:
-    int searchDepth;
+    SearchLimits limits;
+    TranspositionTable table;
+    int orderingFlags = ORDER_ALL;
+    SearchOptions options;
+    vector<SearchThread> workers; // workers[0] to wątek główny
+    shared_ptr<const OpeningBook> book;
+    int endgameThreshold = 0;
+    int tableSizeMB;
+    unique_ptr<Solver> endgame; // tworzony przy pierwszej końcówce
+    bool speedupBenchmark = false;
+    unique_ptr<TranspositionTable> referenceTable; // dla przebiegu wzorcowego
 
 public:
-    AlphaBetaPlayer(int depth = 3);
+    AlphaBetaPlayer(int depth = 3, int ttSizeMB = 16, int threads = 1);
+    AlphaBetaPlayer(SearchLimits limits, int ttSizeMB = 16, int threads = 1);
 
     int chooseMove(const Game &game) override;
+    void clearSearchState() override;
+    void setMoveOrdering(int flags);
+    void setPrincipalVariation(bool enabled);
+    void setAspirationWindow(int halfWidth);
+    void setOpeningBook(shared_ptr<const OpeningBook> openingBook);
+    void setEndgameThreshold(int emptyCells);
+    void setSpeedupBenchmark(bool enabled);
 
     void saveMovesAnalyze() const override;
 
 private:
-    int minimax(Game &game, int depth, bool myTurn, char myChar, int alpha, int beta);
+    double measureSpeedup(const Game &game, const MoveList &validMoves, int emptyCells);
 };
 
-AlphaBetaPlayer::AlphaBetaPlayer(int depth) : AIPlayer("AlphaBeta_AI"), searchDepth(depth) {}
+AlphaBetaPlayer::AlphaBetaPlayer(int depth, int ttSizeMB, int threads)
+    : AlphaBetaPlayer(SearchLimits(depth), ttSizeMB, threads)
+{
+}
+
+AlphaBetaPlayer::AlphaBetaPlayer(SearchLimits limits, int ttSizeMB, int threads)
+    : AIPlayer("AlphaBeta_AI"),
+      limits(limits),
+      table(ttSizeMB),
+      workers(max(1, threads)),
+      tableSizeMB(ttSizeMB)
+{
+    for (int i = 0; i < (int)workers.size(); i++)
+    {
+        workers[i].id = i;
+    }
+}
 
 int AlphaBetaPlayer::chooseMove(const Game &game)
 {
@@ -33,7 +100,25 @@ int AlphaBetaPlayer::chooseMove(const Game &game)
 
     auto startTime = chrono::high_resolution_clock::now();
 
-    vector<int> validMoves = game.getValidMoves();
+    BookEntry bookEntry;
+    if (book && book->lookup(game, bookEntry))
+    {
+        lastMoveStats = MoveStats{
+            0, 0,
+            chrono::duration_cast<chrono::microseconds>(
+                chrono::high_resolution_clock::now() - startTime),
+            bookEntry.bestMove};
+        lastMoveStats.evalScore = bookEntry.exact ? bookEntry.score : bookEntry.eval;
+        lastMoveStats.solved = bookEntry.exact;
+        lastMoveStats.fromBook = true;
+        allMovesStats.push_back(lastMoveStats);
+        return bookEntry.bestMove;
+    }
+
+    table.newSearch();
+
+    MoveList validMoves;
+    game.generateDistinctMoves(validMoves);
 
     if (validMoves.empty())
     {
@@ -45,33 +130,82 @@ int AlphaBetaPlayer::chooseMove(const Game &game)
         return -1;
     }
 
-    auto gameCopy = game.clone();
-    char currentPlayer = gameCopy->getCurrentPlayer();
-    char opponent = (currentPlayer == 'X') ? 'O' : 'X';
+    int emptyCells = game.getMaxMoves() - game.getMoveCount();
 
-    int bestEvalDif = INT_MIN;
-    int bestMove = -1;
+    chrono::microseconds solveTime(0);
+    long long solveNodes = 0;
+    SearchLimits searchLimits = limits;
+    if (emptyCells <= endgameThreshold && Solver::fitsBoard(game.getRows(), game.getCols()))
+    {
+        if (!endgame)
+            endgame = make_unique<Solver>(tableSizeMB);
 
-    int alpha = INT_MIN;
-    int beta = INT_MAX;
+        // połowa budżetu (bez budżetu - bez limitu, jak dotąd)
+        SearchLimits solveLimits = limits.remaining(limits.timeBudget / 2, limits.nodeBudget / 2);
+        SolveResult result = endgame->solve(game, solveLimits);
+        solveTime = chrono::duration_cast<chrono::microseconds>(
+            chrono::high_resolution_clock::now() - startTime);
+        solveNodes = result.nodes;
 
-    for (int move : validMoves)
-    {
-        if (!gameCopy->makeMove(move))
+        if (result.solved && result.bestMove > 0)
         {
-            continue;
+            nodesVisited = (int)result.nodes;
+            lastMoveStats = MoveStats{nodesVisited, 0, solveTime, result.bestMove};
+            lastMoveStats.evalScore = result.score;
+            lastMoveStats.solved = true;
+            lastMoveStats.pliesToEnd = result.plies;
+            lastMoveStats.solveTime = solveTime;
+            allMovesStats.push_back(lastMoveStats);
+            return result.bestMove;
         }
 
-        int evalDiff = minimax(*gameCopy, searchDepth - 1, false, currentPlayer, alpha, beta);
+        // ruch ma zmieścić się w jednym budżecie razem z nieudaną próbą
+        searchLimits = limits.remaining(solveTime, solveNodes);
+    }
 
-        if (evalDiff > bestEvalDif)
-        {
-            bestEvalDif = evalDiff;
-            bestMove = move;
-        }
-        alpha = max(alpha, bestEvalDif);
-        gameCopy->undoMove();
+    bool benchmark = speedupBenchmark && workers.size() > 1;
+    if (benchmark)
+        clearSearchState();
+
+    for (SearchThread &worker : workers)
+    {
+        worker.clearCounters();
+        worker.game = game.clone();
+        worker.ordering.setFlags(orderingFlags);
+        worker.ordering.newSearch(game.getCols(), searchLimits.maxDepth + 1);
+        worker.bestMove = validMoves[0];
+    }
+
+    visitConcreteGame(*workers[0].game, [&](auto &concreteGame)
+                      {
+                          using GameT = remove_reference_t<decltype(concreteGame)>;
+                          Search<GameT>(searchLimits, table, options, workers).run(validMoves, emptyCells);
+                      });
+
+    // wynik z najgłębszej ukończonej iteracji, przy remisie z wątku głównego
+    const SearchThread *best = &workers[0];
+    for (const SearchThread &worker : workers)
+    {
+        if (worker.depthReached > best->depthReached)
+            best = &worker;
+    }
+
+    MoveStats totals;
+    int reusedHits = 0;
+    for (const SearchThread &worker : workers)
+    {
+        totals.nodesVisited += worker.nodesVisited;
+        totals.prunedBranches += worker.prunedBranches;
+        totals.firstMoveCutoffs += worker.firstMoveCutoffs;
+        totals.ttProbes += worker.ttProbes;
+        totals.ttHits += worker.ttHits;
+        reusedHits += worker.ttReusedHits;
+        totals.ttCutoffs += worker.ttCutoffs;
+        totals.pvsResearches += worker.pvsResearches;
+        totals.aspirationResearches += worker.aspirationResearches;
     }
+    nodesVisited = totals.nodesVisited + (int)solveNodes;
+    prunedBranches = totals.prunedBranches;
 
     auto endTime = chrono::high_resolution_clock::now();
 
@@ -79,67 +213,107 @@ int AlphaBetaPlayer::chooseMove(const Game &game)
         nodesVisited,
         prunedBranches,
         chrono::duration_cast<chrono::microseconds>(endTime - startTime),
-        bestMove};
+        best->bestMove};
+    lastMoveStats.evalScore = best->bestEval;
+    lastMoveStats.depthReached = best->depthReached;
+    lastMoveStats.firstMoveCutoffs = totals.firstMoveCutoffs;
+    lastMoveStats.ttProbes = totals.ttProbes;
+    lastMoveStats.ttHits = totals.ttHits;
+    lastMoveStats.ttCutoffs = totals.ttCutoffs;
+    lastMoveStats.reusedFraction = totals.ttHits > 0 ? (double)reusedHits / totals.ttHits : 0.0;
+    lastMoveStats.pvsResearches = totals.pvsResearches;
+    lastMoveStats.aspirationResearches = totals.aspirationResearches;
+    lastMoveStats.solveTime = solveTime;
+    lastMoveStats.threadsUsed = workers.size();
+    if (benchmark)
+        lastMoveStats.parallelSpeedup = measureSpeedup(game, validMoves, emptyCells);
 
     allMovesStats.push_back(lastMoveStats);
 
     // printMoveStats();
 
-    return bestMove;
+    return best->bestMove;
 }
 
-int AlphaBetaPlayer::minimax(Game &game, int depth, bool myTurn, char myChar, int alpha, int beta)
+void AlphaBetaPlayer::setMoveOrdering(int flags)
 {
-    addNodesVisited();
-    char opponent = (myChar == 'X') ? 'O' : 'X';
+    orderingFlags = flags;
+}
 
-    if (depth == 0)
-    {
-        return game.getEval(myChar) - game.getEval(opponent);
-    }
+void AlphaBetaPlayer::setPrincipalVariation(bool enabled)
+{
+    options.principalVariation = enabled;
+}
 
-    vector<int> validMoves = game.getValidMoves();
+void AlphaBetaPlayer::setAspirationWindow(int halfWidth)
+{
+    options.aspirationWindow = max(0, halfWidth);
+}
 
-    if (myTurn)
-    {
-        int maxEvalScore = INT_MIN;
-        for (int move : validMoves)
-        {
-            game.makeMove(move);
-            int evalScore = minimax(game, depth - 1, false, myChar, alpha, beta);
-            game.undoMove();
-
-            maxEvalScore = max(maxEvalScore, evalScore);
-            alpha = max(alpha, evalScore);
-
-            if (beta <= alpha)
-            {
-                addPrunedBranches();
-                break;
-            }
-        }
-        return maxEvalScore;
-    }
-    else
+void AlphaBetaPlayer::setOpeningBook(shared_ptr<const OpeningBook> openingBook)
+{
+    book = openingBook;
+}
+
+// Tablica solvera zostaje - jego wyniki są dokładne, więc ważne w każdej partii.
+void AlphaBetaPlayer::clearSearchState()
+{
+    table.clear();
+    for (SearchThread &worker : workers)
+        worker.ordering.clear();
+}
+
+// 0 wyłącza solver końcówek.
+void AlphaBetaPlayer::setEndgameThreshold(int emptyCells)
+{
+    endgameThreshold = max(0, emptyCells);
+}
+
+// Kosztuje drugi, jednowątkowy przebieg na ruch - tylko do pomiarów.
+void AlphaBetaPlayer::setSpeedupBenchmark(bool enabled)
+{
+    speedupBenchmark = enabled;
+}
+
+// Czas jednego wątku do głębokości, którą osiągnęło wyszukiwanie równoległe,
+// podzielony przez czas, w którym osiągnęło ją ono. Sam stosunek węzłów nic
+// tu nie mówi - w Lazy SMP pomocnicze wątki liczą do końca ruchu, a duża
+// część ich węzłów to powtórzona praca.
+double AlphaBetaPlayer::measureSpeedup(const Game &game, const MoveList &validMoves, int emptyCells)
+{
+    // pierwszy wątek, który ukończył najgłębszą iterację
+    int depth = 0;
+    chrono::microseconds parallelTime(0);
+    for (const SearchThread &worker : workers)
     {
-        int minEvalScore = INT_MAX;
-        for (int move : validMoves)
+        if (worker.depthReached > depth ||
+            (worker.depthReached == depth && worker.depthTime < parallelTime))
         {
-            game.makeMove(move);
-            int evalScore = minimax(game, depth - 1, true, myChar, alpha, beta);
-            game.undoMove();
-
-            minEvalScore = min(minEvalScore, evalScore);
-            beta = min(beta, evalScore);
-
-            if (beta <= alpha)
-            {
-                addPrunedBranches();
-                break;
-            }
+            depth = worker.depthReached;
+            parallelTime = worker.depthTime;
         }
-        return minEvalScore;
     }
+    if (depth == 0 || parallelTime.count() == 0)
+        return 0.0;
+
+    if (!referenceTable)
+        referenceTable = make_unique<TranspositionTable>(tableSizeMB);
+    referenceTable->clear();
+
+    vector<SearchThread> reference(1);
+    reference[0].game = game.clone();
+    reference[0].ordering.setFlags(orderingFlags);
+    reference[0].ordering.newSearch(game.getCols(), depth + 1);
+    reference[0].bestMove = validMoves[0];
+
+    SearchLimits referenceLimits(depth);
+    visitConcreteGame(*reference[0].game, [&](auto &concreteGame)
+                      {
+                          using GameT = remove_reference_t<decltype(concreteGame)>;
+                          Search<GameT>(referenceLimits, *referenceTable, options, reference).run(validMoves, emptyCells);
+                      });
+
+    return (double)reference[0].depthTime.count() / parallelTime.count();
 }
 
 void AlphaBetaPlayer::saveMovesAnalyze() const
@@ -165,6 +339,8 @@ void AlphaBetaPlayer::saveMovesAnalyze() const
             file << avgStats.nodesVisited << ";";
             file << avgStats.prunedBranches << ";";
             file << avgStats.timeTaken.count() / 1000.0 << ";";
+            file << avgStats.ttHits << ";";
+            file << avgStats.ttCutoffs << ";";
         }
         file.close();
     }
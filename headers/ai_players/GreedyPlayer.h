@@ -23,9 +23,9 @@ int GreedyPlayer::chooseMove(const Game &game)
     auto startTime = chrono::high_resolution_clock::now();
 
     char currentPlayer = game.getCurrentPlayer();
-    char opponent = (currentPlayer == 'X') ? 'O' : 'X';
 
-    auto validMoves = game.getValidMoves();
+    MoveList validMoves;
+    game.generateMoves(validMoves);
 
     if (validMoves.empty())
     {
@@ -38,20 +38,15 @@ int GreedyPlayer::chooseMove(const Game &game)
         return -1;
     }
 
-    int bestEvalDif = INT_MIN;
+    // zmiana oceny po każdym ruchu naraz, bez kopiowania i ruszania planszy
+    int deltas[Game::MAX_SIZE];
+    game.evalDeltas(currentPlayer, deltas);
 
-    auto gameCopy = game.clone();
+    int bestEvalDif = INT_MIN;
 
     for (int move : validMoves)
     {
-        if (!gameCopy->makeMove(move))
-        {
-            continue;
-        }
-
-        int eval = gameCopy->getEval(currentPlayer);
-        int evalOpp = gameCopy->getEval(opponent);
-        int evalDiff = eval - evalOpp;
+        int evalDiff = deltas[move - 1];
 
         if (evalDiff > bestEvalDif)
         {
@@ -64,7 +59,6 @@ int GreedyPlayer::chooseMove(const Game &game)
             addPosibleMove(move);
         }
         addNodesVisited();
-        gameCopy->undoMove();
     }
 
     int chosenMove = getRandomMove();
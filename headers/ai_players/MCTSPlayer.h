@@ -0,0 +1,379 @@
+#pragma once
+#include <iostream>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <cmath>
+#include "AIPlayer.h"
+#include "../search/SearchLimits.h"
+#include "../search/MCTSTree.h"
+#include "../search/Playout.h"
+
+using namespace std;
+
+// Monte Carlo Tree Search z UCT. Każda iteracja schodzi od korzenia po
+// dzieciach z największym UCB1, rozwija liść odwiedzony drugi raz, rozgrywa
+// z niego losową partię (randomPlayout) i dodaje wynik na całej ścieżce.
+// Ruch to najczęściej odwiedzone dziecko korzenia.
+//
+// Wątki dzielą jedno drzewo: statystyki węzłów są atomowe, dzieci rozwija
+// ten wątek, który pierwszy przestawi stan węzła, a wirtualna przegrana
+// (wizyta liczona przed rozgrywką) rozprowadza wątki po różnych gałęziach.
+// Siła rośnie z liczbą rdzeni i z czasem, a nie wykładniczo z głębokością.
+//
+// Drzewo przechodzi na kolejny ruch partii: jeśli nowa pozycja jest w nim
+// (zwykle wnuk poprzedniego korzenia - nasz ruch i odpowiedź rywala), jej
+// poddrzewo zostaje nowym korzeniem razem ze statystykami, a reszta puli
+// jest zwalniana. Drzewo jest czyszczone w clearSearchState (nowa partia).
+//
+// Budżet: nodeBudget z SearchLimits to liczba rozgrywek, timeBudget czas
+// na ruch; maxDepth nie ma znaczenia.
+class MCTSPlayer : public AIPlayer
+{
+private:
+    SearchLimits limits;
+    int threadCount;
+    double exploration = 1.4;
+    MCTSTree tree;
+
+    BitboardPosition root;
+    bool hasTree = false; // drzewo z poprzedniego ruchu leży w puli
+    atomic<long long> started{0};
+    atomic<bool> stopped{false};
+    chrono::high_resolution_clock::time_point searchStart;
+
+public:
+    MCTSPlayer(int playouts = 10000, int threads = 1, int treeSizeMB = 32);
+    MCTSPlayer(SearchLimits limits, int threads = 1, int treeSizeMB = 32);
+
+    int chooseMove(const Game &game) override;
+    void setExploration(double constant);
+    void clearSearchState() override;
+
+private:
+    int findPosition(const BitboardPosition &position) const;
+    long long runPlayouts(uint64_t seed);
+    void iterate(BitboardPosition board, FastRandom &random);
+    bool expand(MCTSNode &node, const BitboardPosition &board);
+    int selectChild(const MCTSNode &node) const;
+    bool budgetExceeded(long long playouts);
+};
+
+MCTSPlayer::MCTSPlayer(int playouts, int threads, int treeSizeMB)
+    : MCTSPlayer(SearchLimits(0, chrono::milliseconds(0), playouts), threads, treeSizeMB)
+{
+}
+
+MCTSPlayer::MCTSPlayer(SearchLimits limits, int threads, int treeSizeMB)
+    : AIPlayer("MCTS_AI"),
+      limits(limits),
+      threadCount(max(1, threads)),
+      tree(treeSizeMB)
+{
+}
+
+int MCTSPlayer::chooseMove(const Game &game)
+{
+    clearNodesBranches();
+    clearPossibleMoves();
+
+    auto startTime = chrono::high_resolution_clock::now();
+
+    game.generateMoves(possibleMoves);
+
+    if (possibleMoves.empty())
+    {
+        lastMoveStats = MoveStats{
+            0, 0,
+            chrono::duration_cast<chrono::milliseconds>(
+                chrono::high_resolution_clock::now() - startTime),
+            -1};
+        return -1;
+    }
+
+    if (!BitboardPosition::fitsBoard(game.getRows(), game.getCols()))
+    {
+        printf("Plansza %dx%d nie mieści się w masce bitowej MCTS, ruch losowy.\n", game.getRows(), game.getCols());
+        int move = getRandomMove();
+        lastMoveStats = MoveStats{
+            0, 0,
+            chrono::duration_cast<chrono::microseconds>(
+                chrono::high_resolution_clock::now() - startTime),
+            move};
+        allMovesStats.push_back(lastMoveStats);
+        return move;
+    }
+
+    BitboardPosition position;
+    position.load(game);
+
+    int inheritedVisits = 0;
+    int reusedRoot = hasTree ? findPosition(position) : -1;
+    if (reusedRoot >= 0 && !tree[reusedRoot].terminal)
+    {
+        tree.keepSubtree(reusedRoot);
+        inheritedVisits = tree[0].visits.load();
+    }
+    else
+    {
+        tree.clear();
+        tree[tree.allocate(1)].init(0, 0);
+    }
+    root = position;
+    hasTree = true;
+    if (tree[0].state.load() != MCTSNode::EXPANDED)
+        expand(tree[0], root);
+
+    started = 0;
+    stopped = false;
+    searchStart = chrono::high_resolution_clock::now();
+
+    vector<long long> playouts(threadCount, 0);
+    vector<thread> helpers;
+    for (int i = 1; i < threadCount; i++)
+    {
+        uint64_t seed = gen();
+        helpers.emplace_back([this, i, seed, &playouts]()
+                             { playouts[i] = runPlayouts(seed); });
+    }
+    playouts[0] = runPlayouts(gen());
+
+    stopped = true;
+    for (thread &helper : helpers)
+    {
+        helper.join();
+    }
+
+    // najczęściej odwiedzone dziecko; wygrana od razu zawsze wygrywa
+    const MCTSNode &rootNode = tree[0];
+    int best = rootNode.firstChild;
+    for (int i = rootNode.firstChild; i < rootNode.firstChild + rootNode.childCount; i++)
+    {
+        if (tree[i].terminal == 2)
+        {
+            best = i;
+            break;
+        }
+        if (tree[i].visits.load() > tree[best].visits.load())
+            best = i;
+    }
+
+    long long totalPlayouts = 0;
+    for (long long count : playouts)
+        totalPlayouts += count;
+    nodesVisited = (int)totalPlayouts;
+
+    auto endTime = chrono::high_resolution_clock::now();
+    double seconds = chrono::duration<double>(endTime - searchStart).count();
+
+    int visits = tree[best].visits.load();
+    lastMoveStats = MoveStats{
+        nodesVisited,
+        0,
+        chrono::duration_cast<chrono::microseconds>(endTime - startTime),
+        tree[best].move};
+    lastMoveStats.evalScore = visits > 0 ? (int)(tree[best].score.load() * 500LL / visits) : 0;
+    lastMoveStats.threadsUsed = threadCount;
+    lastMoveStats.playoutsPerSecond = seconds > 0 ? totalPlayouts / seconds : 0.0;
+    lastMoveStats.treeNodes = tree.size();
+    lastMoveStats.reusedFraction = tree[0].visits.load() > 0
+                                       ? (double)inheritedVisits / tree[0].visits.load()
+                                       : 0.0;
+
+    allMovesStats.push_back(lastMoveStats);
+
+    // printMoveStats();
+
+    return tree[best].move;
+}
+
+// Stała eksploracji C w UCB1 = wynik / wizyty + C * sqrt(ln(wizyty rodzica) / wizyty).
+void MCTSPlayer::setExploration(double constant)
+{
+    exploration = max(0.0, constant);
+}
+
+void MCTSPlayer::clearSearchState()
+{
+    tree.clear();
+    hasTree = false;
+}
+
+// Węzeł poprzedniego drzewa z pozycją position: korzeń, dziecko albo wnuk;
+// -1, gdy go nie ma (inna partia, inna plansza albo gałąź nierozwinięta).
+int MCTSPlayer::findPosition(const BitboardPosition &position) const
+{
+    if (root.samePosition(position))
+        return 0;
+
+    int plies = position.getMoveCount() - root.getMoveCount();
+    if (plies < 1 || plies > 2)
+        return -1;
+
+    const MCTSNode &rootNode = tree[0];
+    if (rootNode.state.load() != MCTSNode::EXPANDED)
+        return -1;
+
+    for (int i = rootNode.firstChild; i < rootNode.firstChild + rootNode.childCount; i++)
+    {
+        BitboardPosition child = root;
+        child.play(child.columnMove(tree[i].move - 1));
+        if (plies == 1)
+        {
+            if (child.samePosition(position))
+                return i;
+            continue;
+        }
+
+        const MCTSNode &childNode = tree[i];
+        if (childNode.terminal || childNode.state.load() != MCTSNode::EXPANDED)
+            continue;
+        for (int j = childNode.firstChild; j < childNode.firstChild + childNode.childCount; j++)
+        {
+            BitboardPosition grandchild = child;
+            grandchild.play(grandchild.columnMove(tree[j].move - 1));
+            if (grandchild.samePosition(position))
+                return j;
+        }
+    }
+    return -1;
+}
+
+// Pętla jednego wątku; zwraca liczbę jego rozgrywek.
+long long MCTSPlayer::runPlayouts(uint64_t seed)
+{
+    FastRandom random(seed);
+    long long playouts = 0;
+    while (!budgetExceeded(playouts))
+    {
+        iterate(root, random);
+        playouts++;
+    }
+    return playouts;
+}
+
+// Jedna iteracja na kopii pozycji z korzenia. Wynik rośnie w górę ścieżki
+// z naprzemienną perspektywą: 2 - wynik dziecka to wynik rodzica.
+void MCTSPlayer::iterate(BitboardPosition board, FastRandom &random)
+{
+    int path[64 + 1]; // BitboardPosition ma najwyżej 64 pola
+    int length = 0;
+
+    int index = 0;
+    MCTSNode *node = &tree[index];
+    node->visits.fetch_add(1, memory_order_relaxed);
+    path[length++] = index;
+
+    int result; // dla gracza, który zagrał ruch do ostatniego węzła ścieżki
+    while (true)
+    {
+        if (node->terminal)
+        {
+            result = node->terminal;
+            break;
+        }
+
+        bool expanded = node->state.load(memory_order_acquire) == MCTSNode::EXPANDED;
+        if (!expanded && node->visits.load(memory_order_relaxed) >= 2)
+            expanded = expand(*node, board);
+        if (!expanded)
+        {
+            // playout liczy z perspektywy gracza na ruchu, czyli rywala
+            result = 1 - randomPlayout(board, random);
+            break;
+        }
+
+        index = selectChild(*node);
+        node = &tree[index];
+        node->visits.fetch_add(1, memory_order_relaxed);
+        board.play(board.columnMove(node->move - 1));
+        path[length++] = index;
+    }
+
+    for (int i = length - 1; i >= 0; i--)
+    {
+        tree[path[i]].score.fetch_add(result, memory_order_relaxed);
+        result = 2 - result;
+    }
+}
+
+// Dzieci dla wszystkich ruchów naraz, od środka na zewnątrz. Rozwija tylko
+// wątek, który przestawi stan LEAF -> EXPANDING; pozostałe w tym czasie
+// robią rozgrywkę z liścia. Przy pełnej puli liść zostaje liściem.
+bool MCTSPlayer::expand(MCTSNode &node, const BitboardPosition &board)
+{
+    uint8_t expected = MCTSNode::LEAF;
+    if (!node.state.compare_exchange_strong(expected, MCTSNode::EXPANDING, memory_order_acq_rel))
+        return false;
+
+    int cols = board.getCols();
+    int count = __builtin_popcountll(board.possibleMoves());
+    int first = tree.allocate(count);
+    if (first < 0)
+    {
+        node.state.store(MCTSNode::LEAF, memory_order_release);
+        return false;
+    }
+
+    int child = first;
+    for (int i = 0; i < cols; i++)
+    {
+        int col = board.orderedColumn(i);
+        uint64_t move = board.columnMove(col);
+        if (!move)
+            continue;
+
+        int terminal = 0;
+        if (board.isWinningMove(move))
+            terminal = 2;
+        else if (board.getMoveCount() + 1 == board.getCells())
+            terminal = 1;
+        tree[child++].init(col + 1, terminal);
+    }
+
+    node.firstChild = first;
+    node.childCount = count;
+    node.state.store(MCTSNode::EXPANDED, memory_order_release);
+    return true;
+}
+
+int MCTSPlayer::selectChild(const MCTSNode &node) const
+{
+    double logVisits = log((double)max(1, node.visits.load(memory_order_relaxed)));
+
+    int best = node.firstChild;
+    double bestValue = -1.0;
+    for (int i = node.firstChild; i < node.firstChild + node.childCount; i++)
+    {
+        const MCTSNode &child = tree[i];
+        int visits = child.visits.load(memory_order_relaxed);
+        if (visits == 0 || child.terminal == 2)
+            return i;
+
+        double value = child.score.load(memory_order_relaxed) / (2.0 * visits) +
+                       exploration * sqrt(logVisits / visits);
+        if (value > bestValue)
+        {
+            bestValue = value;
+            best = i;
+        }
+    }
+    return best;
+}
+
+// Budżet rozgrywek jest wspólny dla wątków; zegar każdy wątek sprawdza
+// co 64 własne rozgrywki. Bez żadnego budżetu - 10000 rozgrywek.
+bool MCTSPlayer::budgetExceeded(long long playouts)
+{
+    if (stopped.load(memory_order_relaxed))
+        return true;
+
+    long long budget = limits.hasBudget() ? limits.nodeBudget : 10000;
+    if (budget > 0 && started.fetch_add(1, memory_order_relaxed) >= budget)
+        stopped = true;
+    else if (limits.timeBudget.count() > 0 && (playouts & 63) == 0 &&
+             chrono::high_resolution_clock::now() - searchStart >= limits.timeBudget)
+        stopped = true;
+
+    return stopped.load(memory_order_relaxed);
+}
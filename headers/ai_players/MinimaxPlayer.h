@@ -5,24 +5,31 @@
 #include "AIPlayer.h"
 #include "../game/Game.h"
 #include "../stats/MoveStats.h"
+#include "../search/Search.h"
 
 using namespace std;
 
+// Pełne przeszukiwanie bez odcięć, na wspólnym rdzeniu Search<GameT>.
 class MinimaxPlayer : public AIPlayer
 {
 private:
-    int searchDepth;
+    SearchLimits limits;
+    TranspositionTable table;     // wyłączona - minimax jej nie używa
+    vector<SearchThread> workers; // jeden wątek
 
 public:
     MinimaxPlayer(int depth = 3);
 
     int chooseMove(const Game &game) override;
-
-private:
-    int minimax(Game &game, int depth, bool myTurn, char myChar);
 };
 
-MinimaxPlayer::MinimaxPlayer(int depth) : AIPlayer("Minimax_AI"), searchDepth(depth) {}
+MinimaxPlayer::MinimaxPlayer(int depth)
+    : AIPlayer("Minimax_AI"),
+      limits(depth),
+      table(0),
+      workers(1)
+{
+}
 
 int MinimaxPlayer::chooseMove(const Game &game)
 {
@@ -31,7 +38,8 @@ int MinimaxPlayer::chooseMove(const Game &game)
 
     auto startTime = chrono::high_resolution_clock::now();
 
-    vector<int> validMoves = game.getValidMoves();
+    MoveList validMoves;
+    game.generateMoves(validMoves);
 
     if (validMoves.empty())
     {
@@ -43,29 +51,18 @@ int MinimaxPlayer::chooseMove(const Game &game)
         return -1;
     }
 
-    auto gameCopy = game.clone();
-    char currentPlayer = gameCopy->getCurrentPlayer();
-    char opponent = (currentPlayer == 'X') ? 'O' : 'X';
+    SearchThread &worker = workers[0];
+    worker.clearCounters();
+    worker.game = game.clone();
 
-    int bestEvalDif = INT_MIN;
     int bestMove = -1;
-
-    for (int move : validMoves)
-    {
-        if (!gameCopy->makeMove(move))
-        {
-            continue;
-        }
-
-        int evalDiff = minimax(*gameCopy, searchDepth - 1, false, currentPlayer);
-
-        if (evalDiff > bestEvalDif)
-        {
-            bestEvalDif = evalDiff;
-            bestMove = move;
-        }
-        gameCopy->undoMove();
-    }
+    visitConcreteGame(*worker.game, [&](auto &concreteGame)
+                      {
+                          using GameT = remove_reference_t<decltype(concreteGame)>;
+                          Search<GameT>(limits, table, SearchOptions(), workers)
+                              .searchMinimax(worker, limits.maxDepth, validMoves, bestMove);
+                      });
+    nodesVisited = worker.nodesVisited;
 
     auto endTime = chrono::high_resolution_clock::now();
 
@@ -80,43 +77,3 @@ int MinimaxPlayer::chooseMove(const Game &game)
 
     return bestMove;
 }
-
-int MinimaxPlayer::minimax(Game &game, int depth, bool myTurn, char myChar)
-{
-    char opponent = (myChar == 'X') ? 'O' : 'X';
-    addNodesVisited();
-
-    if (depth == 0)
-    {
-        return game.getEval(myChar) - game.getEval(opponent);
-    }
-
-    vector<int> validMoves = game.getValidMoves();
-
-    if (myTurn)
-    {
-        int maxEvalScore = INT_MIN;
-        for (int move : validMoves)
-        {
-            game.makeMove(move);
-            int evalScore = minimax(game, depth - 1, false, myChar);
-            game.undoMove();
-            if (evalScore > maxEvalScore)
-                maxEvalScore = evalScore;
-        }
-        return maxEvalScore;
-    }
-    else
-    {
-        int minEvalScore = INT_MAX;
-        for (int move : validMoves)
-        {
-            game.makeMove(move);
-            int evalScore = minimax(game, depth - 1, true, myChar);
-            game.undoMove();
-            if (evalScore < minEvalScore)
-                minEvalScore = evalScore;
-        }
-        return minEvalScore;
-    }
-}
@@ -23,10 +23,7 @@ int RandomPlayer::chooseMove(const Game &game)
 
     auto startTime = chrono::high_resolution_clock::now();
 
-    for (int move : game.getValidMoves())
-    {
-        addPosibleMove(move);
-    }
+    game.generateMoves(possibleMoves);
 
     if (possibleMoves.empty())
     {
@@ -0,0 +1,98 @@
+#pragma once
+#include <iostream>
+#include <chrono>
+#include "AIPlayer.h"
+#include "AlphaBetaPlayer.h"
+#include "../search/Solver.h"
+#include "../search/SearchLimits.h"
+
+using namespace std;
+
+// Gracz idealny: ruch i dokładna wartość pozycji (wygrana / remis / przegrana
+// i liczba ruchów do końca) z Solvera. Punkt odniesienia do mierzenia, ile
+// tracą gracze heurystyczni.
+//
+// Solver dostaje budżet czasu na ruch. Gdy go nie wystarczy (początek
+// partii) albo plansza nie mieści się w masce bitowej, ruch wybiera
+// AlphaBetaPlayer z iteracyjnym pogłębianiem we własnym budżecie - ruch
+// trwa wtedy najwyżej sumę obu.
+class SolverPlayer : public AIPlayer
+{
+private:
+    Solver solver;
+    SearchLimits solverLimits;
+    AlphaBetaPlayer fallback;
+    SolveResult lastResult;
+
+public:
+    SolverPlayer(chrono::milliseconds solveBudget = chrono::milliseconds(1000),
+                 chrono::milliseconds fallbackBudget = chrono::milliseconds(500),
+                 int ttSizeMB = 64);
+
+    int chooseMove(const Game &game) override;
+    void clearSearchState() override;
+    SolveResult getLastResult() const;
+};
+
+SolverPlayer::SolverPlayer(chrono::milliseconds solveBudget, chrono::milliseconds fallbackBudget, int ttSizeMB)
+    : AIPlayer("Solver_AI"),
+      solver(ttSizeMB),
+      solverLimits(Game::MAX_SIZE * Game::MAX_SIZE, solveBudget),
+      fallback(SearchLimits(Game::MAX_SIZE * Game::MAX_SIZE, fallbackBudget))
+{
+}
+
+int SolverPlayer::chooseMove(const Game &game)
+{
+    clearNodesBranches();
+    clearPossibleMoves();
+
+    auto startTime = chrono::high_resolution_clock::now();
+
+    lastResult = SolveResult();
+    if (Solver::fitsBoard(game.getRows(), game.getCols()))
+        lastResult = solver.solve(game, solverLimits);
+
+    auto solveTime = chrono::duration_cast<chrono::microseconds>(
+        chrono::high_resolution_clock::now() - startTime);
+
+    if (lastResult.solved && lastResult.bestMove > 0)
+    {
+        auto endTime = chrono::high_resolution_clock::now();
+        lastMoveStats = MoveStats{
+            (int)lastResult.nodes,
+            0,
+            chrono::duration_cast<chrono::microseconds>(endTime - startTime),
+            lastResult.bestMove};
+        lastMoveStats.evalScore = lastResult.score;
+        lastMoveStats.solved = true;
+        lastMoveStats.pliesToEnd = lastResult.plies;
+    }
+    else
+    {
+        fallback.chooseMove(game);
+        lastMoveStats = fallback.getLastMoveStats();
+        lastMoveStats.nodesVisited += (int)lastResult.nodes;
+        lastMoveStats.timeTaken = chrono::duration_cast<chrono::microseconds>(
+            chrono::high_resolution_clock::now() - startTime);
+    }
+    lastMoveStats.solveTime = solveTime;
+
+    nodesVisited = lastMoveStats.nodesVisited;
+    allMovesStats.push_back(lastMoveStats);
+
+    // printMoveStats();
+
+    return lastMoveStats.chosenMove;
+}
+
+// Tablica solvera zostaje (wyniki dokładne), czyszczony jest tylko gracz zapasowy.
+void SolverPlayer::clearSearchState()
+{
+    fallback.clearSearchState();
+}
+
+SolveResult SolverPlayer::getLastResult() const
+{
+    return lastResult;
+}
@@ -0,0 +1,351 @@
+#pragma once
+#include <iostream>
+#include <climits>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include "AIPlayer.h"
+#include "../game/Game.h"
+#include "../stats/MoveStats.h"
+#include "../search/TranspositionTable.h"
+#include "../search/MoveOrdering.h"
+#include "../search/SearchThread.h"
+#include "../search/WorkStealingPool.h"
+
+using namespace std;
+
+// Miejsce podziału drzewa: węzeł, którego młodsi bracia są przeszukiwani
+// równolegle. Odcięcie beta w węźle anuluje wszystkie jego zadania, a przez
+// łańcuch rodziców także całe poddrzewa, które z nich wyrosły.
+struct SplitPoint
+{
+    const SplitPoint *parent;
+    atomic<bool> cancelled{false};
+
+    mutex lock;
+    atomic<int> alpha;
+    int beta;
+    int bestScore;
+    int bestMove;
+
+    SplitPoint(const SplitPoint *parent, int alpha, int beta, int bestScore, int bestMove)
+        : parent(parent), alpha(alpha), beta(beta), bestScore(bestScore), bestMove(bestMove) {}
+
+    bool isCancelled() const
+    {
+        for (const SplitPoint *node = this; node; node = node->parent)
+        {
+            if (node->cancelled.load(memory_order_relaxed))
+                return true;
+        }
+        return false;
+    }
+};
+
+// Równoległe alfa-beta w schemacie Young Brothers Wait: w każdym węźle
+// najpierw szeregowo przeszukiwany jest pierwszy (najlepiej uporządkowany)
+// ruch, a dopiero gdy nie dał odcięcia, pozostałe ruchy trafiają jako
+// zadania do puli z kradzieżą pracy. Zadania biorą aktualną alfę węzła
+// w chwili startu, więc później startujący bracia tną mocniej.
+class YBWPlayer : public AIPlayer
+{
+private:
+    // poniżej tej głębokości kopiowanie gry do zadania kosztuje więcej niż zysk
+    static constexpr int MIN_SPLIT_DEPTH = 3;
+
+    int maxDepth;
+    TranspositionTable table;
+    WorkStealingPool pool;
+    vector<SearchThread> workers; // liczniki i heurystyki per wątek puli
+
+public:
+    YBWPlayer(int depth = 7, int ttSizeMB = 16, int threads = thread::hardware_concurrency());
+
+    int chooseMove(const Game &game) override;
+    void clearSearchState() override;
+
+private:
+    int search(Game &game, int depth, int ply, int alpha, int beta, SplitPoint *parent, int &bestMove);
+    void searchSibling(const Game &position, SplitPoint &split, int move, int depth, int ply);
+    SearchThread &currentWorker();
+};
+
+YBWPlayer::YBWPlayer(int depth, int ttSizeMB, int threads)
+    : AIPlayer("YBW_AI"),
+      maxDepth(depth),
+      table(ttSizeMB),
+      pool(threads),
+      workers(pool.size())
+{
+    for (int i = 0; i < (int)workers.size(); i++)
+    {
+        workers[i].id = i;
+    }
+}
+
+int YBWPlayer::chooseMove(const Game &game)
+{
+    clearNodesBranches();
+    clearPossibleMoves();
+    table.newSearch();
+    pool.resetStats();
+
+    auto startTime = chrono::high_resolution_clock::now();
+
+    MoveList validMoves;
+    game.generateMoves(validMoves);
+
+    if (validMoves.empty())
+    {
+        lastMoveStats = MoveStats{
+            0, 0,
+            chrono::duration_cast<chrono::milliseconds>(
+                chrono::high_resolution_clock::now() - startTime),
+            -1};
+        return -1;
+    }
+
+    int emptyCells = game.getMaxMoves() - game.getMoveCount();
+
+    for (SearchThread &worker : workers)
+    {
+        worker.clearCounters();
+        worker.ordering.newSearch(game.getCols(), maxDepth + 1);
+    }
+
+    unique_ptr<Game> root = game.clone();
+    int bestMove = validMoves[0];
+    int bestEval = 0;
+    int depthReached = 0;
+
+    // iteracyjne pogłębianie wypełnia tablicę transpozycji, z której kolejna
+    // iteracja bierze pierwszy ruch - od jego trafności zależy cały YBW
+    pool.begin();
+    for (int depth = 1; depth <= maxDepth; depth++)
+    {
+        int iterationMove = bestMove;
+        bestEval = search(*root, depth, 0, -INT_MAX, INT_MAX, nullptr, iterationMove);
+        bestMove = iterationMove;
+        depthReached = depth;
+
+        if (depth >= emptyCells)
+            break;
+    }
+    pool.end();
+
+    MoveStats totals;
+    int reusedHits = 0;
+    for (const SearchThread &worker : workers)
+    {
+        totals.nodesVisited += worker.nodesVisited;
+        totals.prunedBranches += worker.prunedBranches;
+        totals.firstMoveCutoffs += worker.firstMoveCutoffs;
+        totals.ttProbes += worker.ttProbes;
+        totals.ttHits += worker.ttHits;
+        reusedHits += worker.ttReusedHits;
+        totals.ttCutoffs += worker.ttCutoffs;
+    }
+    nodesVisited = totals.nodesVisited;
+    prunedBranches = totals.prunedBranches;
+
+    auto endTime = chrono::high_resolution_clock::now();
+
+    lastMoveStats = MoveStats{
+        nodesVisited,
+        prunedBranches,
+        chrono::duration_cast<chrono::microseconds>(endTime - startTime),
+        bestMove};
+    lastMoveStats.evalScore = bestEval;
+    lastMoveStats.depthReached = depthReached;
+    lastMoveStats.firstMoveCutoffs = totals.firstMoveCutoffs;
+    lastMoveStats.ttProbes = totals.ttProbes;
+    lastMoveStats.ttHits = totals.ttHits;
+    lastMoveStats.ttCutoffs = totals.ttCutoffs;
+    lastMoveStats.reusedFraction = totals.ttHits > 0 ? (double)reusedHits / totals.ttHits : 0.0;
+    lastMoveStats.threadsUsed = workers.size();
+    lastMoveStats.steals = pool.getSteals();
+    lastMoveStats.idleTime = pool.getIdleTime();
+
+    allMovesStats.push_back(lastMoveStats);
+
+    // printMoveStats();
+
+    return bestMove;
+}
+
+void YBWPlayer::clearSearchState()
+{
+    table.clear();
+    for (SearchThread &worker : workers)
+        worker.ordering.clear();
+}
+
+SearchThread &YBWPlayer::currentWorker()
+{
+    return workers[pool.currentWorker()];
+}
+
+// Negamax z podziałem YBW. Wynik węzła, którego miejsce podziału (albo
+// któryś przodek) zostało anulowane, jest bez znaczenia - wywołujący
+// sprawdza anulowanie przed jego użyciem i nie zapisuje go do tablicy.
+int YBWPlayer::search(Game &game, int depth, int ply, int alpha, int beta, SplitPoint *parent, int &bestMove)
+{
+    SearchThread &worker = currentWorker();
+    worker.nodesVisited++;
+
+    if (parent && parent->isCancelled())
+        return 0;
+
+    char player = game.getCurrentPlayer();
+    char opponent = (player == 'X') ? 'O' : 'X';
+
+    if (depth == 0 || game.isTerminal())
+    {
+        return game.getEval(player) - game.getEval(opponent);
+    }
+
+    int alphaOrig = alpha;
+    // pozycja i jej odbicie dzielą wpis; ruch w tablicy jest w orientacji kanonicznej
+    uint64_t key = game.getCanonicalHash();
+    int hashMove = ply == 0 ? bestMove : 0;
+
+    if (table.isEnabled() && ply > 0)
+    {
+        TTEntry entry;
+        worker.ttProbes++;
+        if (table.probe(key, entry))
+        {
+            worker.ttHits++;
+            if (table.isFromEarlierSearch(entry))
+                worker.ttReusedHits++;
+            hashMove = game.canonicalMove(entry.bestMove);
+            if (entry.depth >= depth &&
+                (entry.bound == BOUND_EXACT ||
+                 (entry.bound == BOUND_LOWER && entry.score >= beta) ||
+                 (entry.bound == BOUND_UPPER && entry.score <= alpha)))
+            {
+                worker.ttCutoffs++;
+                return entry.score;
+            }
+        }
+    }
+
+    MoveList validMoves;
+    if (ply == 0)
+        game.generateDistinctMoves(validMoves);
+    else
+        game.generateMoves(validMoves);
+    worker.ordering.order(validMoves, ply, hashMove, player,
+                          game.winningColumns(player), game.winningColumns(opponent));
+
+    // najstarszy brat zawsze szeregowo
+    int childMove = 0;
+    game.makeMove(validMoves[0]);
+    int maxEvalScore = -search(game, depth - 1, ply + 1, -beta, -alpha, parent, childMove);
+    game.undoMove();
+
+    if (parent && parent->isCancelled())
+        return 0;
+
+    bestMove = validMoves[0];
+    alpha = max(alpha, maxEvalScore);
+
+    if (beta <= alpha)
+    {
+        worker.prunedBranches++;
+        worker.firstMoveCutoffs++;
+        worker.ordering.recordCutoff(bestMove, ply, depth, player);
+    }
+    else if (depth < MIN_SPLIT_DEPTH)
+    {
+        for (int i = 1; i < validMoves.size(); i++)
+        {
+            int move = validMoves[i];
+            game.makeMove(move);
+            int evalScore = -search(game, depth - 1, ply + 1, -beta, -alpha, parent, childMove);
+            game.undoMove();
+
+            if (parent && parent->isCancelled())
+                return 0;
+
+            if (evalScore > maxEvalScore)
+            {
+                maxEvalScore = evalScore;
+                bestMove = move;
+            }
+            alpha = max(alpha, evalScore);
+
+            if (beta <= alpha)
+            {
+                worker.prunedBranches++;
+                worker.ordering.recordCutoff(move, ply, depth, player);
+                break;
+            }
+        }
+    }
+    else
+    {
+        // młodsi bracia równolegle; game nie zmienia się do końca wait(),
+        // więc zadania mogą ją bezpiecznie kopiować
+        SplitPoint split(parent, alpha, beta, maxEvalScore, bestMove);
+        TaskGroup group;
+        for (int i = 1; i < validMoves.size(); i++)
+        {
+            int move = validMoves[i];
+            pool.spawn(group, [this, &game, &split, move, depth, ply]()
+                       { searchSibling(game, split, move, depth, ply); });
+        }
+        pool.wait(group);
+
+        if (parent && parent->isCancelled())
+            return 0;
+
+        maxEvalScore = split.bestScore;
+        bestMove = split.bestMove;
+    }
+
+    BoundType bound = BOUND_EXACT;
+    if (maxEvalScore <= alphaOrig)
+        bound = BOUND_UPPER;
+    else if (maxEvalScore >= beta)
+        bound = BOUND_LOWER;
+    table.store(key, depth, bound, maxEvalScore, game.canonicalMove(bestMove));
+
+    return maxEvalScore;
+}
+
+void YBWPlayer::searchSibling(const Game &position, SplitPoint &split, int move, int depth, int ply)
+{
+    if (split.isCancelled())
+        return;
+
+    unique_ptr<Game> game = position.clone();
+    game->makeMove(move);
+
+    int childMove = 0;
+    int alpha = split.alpha.load();
+    int evalScore = -search(*game, depth - 1, ply + 1, -split.beta, -alpha, &split, childMove);
+
+    if (split.isCancelled())
+        return;
+
+    SearchThread &worker = currentWorker();
+    char player = position.getCurrentPlayer();
+
+    lock_guard<mutex> guard(split.lock);
+    if (evalScore > split.bestScore)
+    {
+        split.bestScore = evalScore;
+        split.bestMove = move;
+    }
+    if (evalScore > split.alpha)
+        split.alpha = evalScore;
+
+    if (split.beta <= split.alpha)
+    {
+        // odcięcie: bracia jeszcze w kolejkach i w trakcie przeszukiwania są zbędni
+        split.cancelled = true;
+        worker.prunedBranches++;
+        worker.ordering.recordCutoff(move, ply, depth, player);
+    }
+}
@@ -0,0 +1,363 @@
+#pragma once
+#include <iostream>
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+#include "Game.h"
+#include "Move.h"
+#include "PatternKernel.h"
+#include "BitboardPosition.h"
+
+using namespace std;
+
+// Connect Four trzymane jako maski bitowe. Każda kolumna zajmuje (rows + 1)
+// kolejnych bitów, od dołu do góry; dodatkowy, zawsze pusty bit na szczycie
+// kolumny oddziela kolumny, dzięki czemu przesunięcia nie "przeskakują"
+// między nimi. Plansza musi się zmieścić w 64 bitach: cols * (rows + 1) <= 64.
+//
+// Ocena liczy wzorce PatternKernelem w tym samym układzie bitów, od razu
+// dla obu graczy - bez przepisywania planszy.
+class BitboardConnectFour final : public Game
+{
+private:
+    int height;          // bity na kolumnę (rows + 1)
+    uint64_t boardMask;  // wszystkie pola planszy
+    uint64_t bottomMask; // najniższe pole każdej kolumny
+    uint64_t maskX = 0;
+    uint64_t maskO = 0;
+    uint64_t heightMask = 0; // w każdej kolumnie jeden bit: pierwsze wolne pole
+    shared_ptr<const PatternKernel> patternKernel; // wspólny dla klonów
+
+public:
+    BitboardConnectFour(int rows, int cols);
+    BitboardConnectFour(int rows, int cols, char currentPlayer);
+    BitboardConnectFour(const BitboardConnectFour &other);
+    BitboardConnectFour &operator=(const BitboardConnectFour &other);
+    unique_ptr<Game> clone() const override;
+
+    static bool fitsBoard(int rows, int cols);
+
+    vector<int> getValidMoves() const override;
+    bool makeMove(int column) override;
+    bool assumeMove(int column, char player) override;
+    void addMove(Move move) override;
+    void undoMove() override;
+    void reset() override;
+    void checkIsGameOver() override;
+    bool isLastMoveWin() const override;
+    bool checkWin(char player) const override;
+    void calculateEval() override;
+    int evaluate(char player) const override;
+    void refreshEval() const override;
+    uint64_t winningColumns(char player) const override;
+    bool canWinNextMove(char player) const;
+    int countOpenThrees(char player) const;
+    int countOpenTwos(char player) const;
+
+private:
+    static int clampCols(int cols);
+    static int clampRows(int rows, int cols);
+
+    void initMasks();
+    uint64_t columnMask(int colIndex) const;
+    uint64_t cellBit(int row, int colIndex) const;
+    uint64_t playerMask(char player) const;
+    uint64_t emptyMask() const;
+    uint64_t winningCells(uint64_t pieces) const;
+    PatternCounts countPatterns() const;
+};
+
+BitboardConnectFour::BitboardConnectFour(int rows, int cols)
+    : Game(clampRows(rows, cols), clampCols(cols))
+{
+    initMasks();
+    patternKernel = make_shared<PatternKernel>(getRows(), getCols(), PatternKernel::COLUMNS);
+}
+
+BitboardConnectFour::BitboardConnectFour(int rows, int cols, char currentPlayer)
+    : Game(clampRows(rows, cols), clampCols(cols), currentPlayer)
+{
+    initMasks();
+    patternKernel = make_shared<PatternKernel>(getRows(), getCols(), PatternKernel::COLUMNS);
+}
+
+BitboardConnectFour::BitboardConnectFour(const BitboardConnectFour &other)
+    : Game(other),
+      height(other.height),
+      boardMask(other.boardMask),
+      bottomMask(other.bottomMask),
+      maskX(other.maskX),
+      maskO(other.maskO),
+      heightMask(other.heightMask),
+      patternKernel(other.patternKernel)
+{
+}
+
+BitboardConnectFour &BitboardConnectFour::operator=(const BitboardConnectFour &other)
+{
+    if (this != &other)
+    {
+        rows = other.rows;
+        cols = other.cols;
+        currentPlayer = other.currentPlayer;
+        moveHistory = other.moveHistory;
+        evalX = other.evalX;
+        evalO = other.evalO;
+        evalDirty = other.evalDirty;
+        winner = other.winner;
+        hash = other.hash;
+        mirrorHash = other.mirrorHash;
+        board = other.board;
+        heights = other.heights;
+        height = other.height;
+        boardMask = other.boardMask;
+        bottomMask = other.bottomMask;
+        maskX = other.maskX;
+        maskO = other.maskO;
+        heightMask = other.heightMask;
+        patternKernel = other.patternKernel;
+    }
+    return *this;
+}
+
+unique_ptr<Game> BitboardConnectFour::clone() const
+{
+    return make_unique<BitboardConnectFour>(*this);
+}
+
+bool BitboardConnectFour::fitsBoard(int rows, int cols)
+{
+    return cols * (rows + 1) <= 64;
+}
+
+int BitboardConnectFour::clampCols(int cols)
+{
+    // przy minimalnych 4 wierszach mieści się najwyżej 12 kolumn
+    return min(max(4, cols), 12);
+}
+
+int BitboardConnectFour::clampRows(int rows, int cols)
+{
+    return min(max(4, rows), 64 / clampCols(cols) - 1);
+}
+
+void BitboardConnectFour::initMasks()
+{
+    height = rows + 1;
+    boardMask = 0;
+    bottomMask = 0;
+    for (int col = 0; col < cols; col++)
+    {
+        bottomMask |= 1ULL << (col * height);
+        boardMask |= ((1ULL << rows) - 1) << (col * height);
+    }
+    maskX = 0;
+    maskO = 0;
+    heightMask = bottomMask;
+}
+
+uint64_t BitboardConnectFour::columnMask(int colIndex) const
+{
+    return ((1ULL << height) - 1) << (colIndex * height);
+}
+
+uint64_t BitboardConnectFour::cellBit(int row, int colIndex) const
+{
+    return 1ULL << (colIndex * height + (rows - 1 - row));
+}
+
+uint64_t BitboardConnectFour::playerMask(char player) const
+{
+    if (player == 'X')
+        return maskX;
+    if (player == 'O')
+        return maskO;
+    return 0;
+}
+
+uint64_t BitboardConnectFour::emptyMask() const
+{
+    return boardMask & ~(maskX | maskO);
+}
+
+vector<int> BitboardConnectFour::getValidMoves() const
+{
+    vector<int> validMoves;
+    uint64_t playable = heightMask & boardMask;
+    for (int col = 0; col < getCols(); col++)
+    {
+        if (playable & columnMask(col))
+        {
+            validMoves.push_back(col + 1);
+        }
+    }
+    return validMoves;
+}
+
+bool BitboardConnectFour::makeMove(int column)
+{
+    if (column < 1 || column > getCols())
+    {
+        printf("Nieprawidłowy numer kolumny! Wybierz od 1 do %d.", getCols());
+        return false;
+    }
+
+    if (!assumeMove(column, getCurrentPlayer()))
+    {
+        printf("Kolumna %d jest już pełna!", column);
+        return false;
+    }
+
+    return true;
+}
+
+bool BitboardConnectFour::assumeMove(int column, char player)
+{
+    if (column < 1 || column > getCols())
+    {
+        printf("Nieprawidłowy numer kolumny! Wybierz od 1 do %d.", getCols());
+        return false;
+    }
+
+    int colIndex = column - 1;
+    uint64_t cell = heightMask & columnMask(colIndex) & boardMask;
+
+    if (!cell)
+    {
+        return false;
+    }
+
+    int row = rows - 1 - (__builtin_ctzll(cell) - colIndex * height);
+    addMove(Move{row, colIndex, player});
+    return true;
+}
+
+void BitboardConnectFour::addMove(Move move)
+{
+    uint64_t cell = cellBit(move.row, move.column);
+    if (move.player == 'X')
+        maskX |= cell;
+    else
+        maskO |= cell;
+    heightMask ^= cell | (cell << 1);
+
+    Game::addMove(move);
+}
+
+void BitboardConnectFour::undoMove()
+{
+    Move move = moveHistory.back();
+    uint64_t cell = cellBit(move.row, move.column);
+    if (move.player == 'X')
+        maskX &= ~cell;
+    else
+        maskO &= ~cell;
+    heightMask ^= cell | (cell << 1);
+
+    Game::undoMove();
+}
+
+void BitboardConnectFour::reset()
+{
+    Game::reset();
+    initMasks();
+}
+
+void BitboardConnectFour::checkIsGameOver()
+{
+    if (isLastMoveWin())
+        setWinner(moveHistory.back().player);
+    else if (getMoveCount() == getMaxMoves())
+        setWinner('D');
+}
+
+bool BitboardConnectFour::isLastMoveWin() const
+{
+    if (moveHistory.empty())
+        return false;
+
+    const Move &last = moveHistory.back();
+    uint64_t pieces = playerMask(last.player);
+    uint64_t cell = cellBit(last.row, last.column);
+
+    for (int shift : {1, height, height - 1, height + 1})
+    {
+        // rozszerzamy ciąg pionków od ostatniego pola w obie strony
+        uint64_t line = cell;
+        for (int step = 0; step < 3; step++)
+            line |= ((line << shift) | (line >> shift)) & pieces;
+        if (__builtin_popcountll(line) >= 4)
+            return true;
+    }
+    return false;
+}
+
+bool BitboardConnectFour::checkWin(char player) const
+{
+    uint64_t pieces = playerMask(player);
+
+    // pionowo, poziomo, ukośnie w dół i ukośnie w górę
+    for (int shift : {1, height, height - 1, height + 1})
+    {
+        uint64_t pairs = pieces & (pieces >> shift);
+        if (pairs & (pairs >> (2 * shift)))
+            return true;
+    }
+    return false;
+}
+
+void BitboardConnectFour::calculateEval()
+{
+    refreshEval();
+    evalDirty = false;
+}
+
+// Jedno liczenie wzorców na obu graczy zamiast dwóch pełnych evaluate.
+void BitboardConnectFour::refreshEval() const
+{
+    PatternCounts counts = countPatterns();
+    evalX = scorePatterns(counts, 0);
+    evalO = scorePatterns(counts, 1);
+}
+
+int BitboardConnectFour::evaluate(char player) const
+{
+    return scorePatterns(countPatterns(), player == 'X' ? 0 : 1);
+}
+
+PatternCounts BitboardConnectFour::countPatterns() const
+{
+    return patternKernel->countBits(maskX, maskO);
+}
+
+uint64_t BitboardConnectFour::winningCells(uint64_t pieces) const
+{
+    return BitboardPosition::threatCells(pieces, height) & emptyMask();
+}
+
+bool BitboardConnectFour::canWinNextMove(char player) const
+{
+    return winningCells(playerMask(player)) & heightMask & boardMask;
+}
+
+uint64_t BitboardConnectFour::winningColumns(char player) const
+{
+    uint64_t cells = winningCells(playerMask(player)) & heightMask & boardMask;
+    uint64_t columns = 0;
+    for (int col = 0; cells && col < getCols(); col++)
+    {
+        if (cells & columnMask(col))
+            columns |= 1ULL << col;
+    }
+    return columns;
+}
+
+int BitboardConnectFour::countOpenThrees(char player) const
+{
+    return countPatterns().threes[player == 'X' ? 0 : 1];
+}
+
+int BitboardConnectFour::countOpenTwos(char player) const
+{
+    return countPatterns().twos[player == 'X' ? 0 : 1];
+}
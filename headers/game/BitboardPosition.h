@@ -0,0 +1,275 @@
+#pragma once
+#include <iostream>
+#include <cstdint>
+#include <algorithm>
+#include "Game.h"
+
+using namespace std;
+
+// Pozycja Connect Four w jednej masce 64-bitowej, dla solvera i rozgrywek
+// MCTS. Układ bitów jak w BitboardConnectFour: kolumna to rows + 1 bitów
+// od dołu, jeden pusty bit oddziela kolumny. current to pionki gracza na
+// ruchu, mask wszystkie pionki - kopiowanie to kilka słów, a ruch nie
+// aktualizuje ani oceny, ani historii.
+class BitboardPosition
+{
+private:
+    int rows = 0;
+    int cols = 0;
+    int height = 0; // rows + 1
+    int cells = 0;
+    uint64_t bottomMask = 0;
+    uint64_t boardMask = 0;
+
+    uint64_t current = 0; // pionki gracza na ruchu
+    uint64_t mask = 0;    // wszystkie pionki
+    int moves = 0;
+
+public:
+    static bool fitsBoard(int rows, int cols);
+    static int centerOutColumn(int cols, int i);
+    static uint64_t threatCells(uint64_t pieces, int height);
+
+    bool setBoardSize(int rows, int cols);
+    void load(const Game &game);
+
+    uint64_t possibleMoves() const;
+    uint64_t columnMask(int col) const;
+    uint64_t columnMove(int col) const;
+    int orderedColumn(int i) const;
+
+    uint64_t winningCells() const;
+    uint64_t opponentWinningCells() const;
+    bool isWinningMove(uint64_t move) const;
+    bool canWinNext() const;
+    uint64_t nonLosingMoves() const;
+    int threatsAfter(uint64_t move) const;
+
+    void play(uint64_t move);
+    void undo(uint64_t move);
+
+    bool isSymmetric() const;
+    uint64_t key() const;
+    bool samePosition(const BitboardPosition &other) const;
+
+    int getRows() const;
+    int getCols() const;
+    int getCells() const;
+    int getMoveCount() const;
+
+private:
+    uint64_t winningCells(uint64_t pieces) const;
+    uint64_t mirror(uint64_t bits) const;
+};
+
+bool BitboardPosition::fitsBoard(int rows, int cols)
+{
+    return cols * (rows + 1) <= 64;
+}
+
+// i-ta kolumna w kolejności od środka na zewnątrz.
+int BitboardPosition::centerOutColumn(int cols, int i)
+{
+    return cols / 2 + (1 - 2 * (i % 2)) * (i + 1) / 2;
+}
+
+// Pola (także zajęte i poza planszą), które domykają czwórkę z pionkami
+// pieces przy kolumnach wysokości height bitów; wołający zostawia wolne.
+uint64_t BitboardPosition::threatCells(uint64_t pieces, int height)
+{
+    // pionowo: trzy pionki pod polem
+    uint64_t winning = (pieces << 1) & (pieces << 2) & (pieces << 3);
+
+    // poziomo i po obu przekątnych
+    for (int shift : {height, height - 1, height + 1})
+    {
+        uint64_t pair = (pieces << shift) & (pieces << 2 * shift);
+        winning |= pair & (pieces << 3 * shift);
+        winning |= pair & (pieces >> shift);
+        pair = (pieces >> shift) & (pieces >> 2 * shift);
+        winning |= pair & (pieces << shift);
+        winning |= pair & (pieces >> 3 * shift);
+    }
+
+    return winning;
+}
+
+// Zwraca true, gdy rozmiar się zmienił (pozycja jest wtedy pusta).
+bool BitboardPosition::setBoardSize(int newRows, int newCols)
+{
+    if (newRows == rows && newCols == cols)
+        return false;
+
+    rows = newRows;
+    cols = newCols;
+    height = rows + 1;
+    cells = rows * cols;
+    bottomMask = 0;
+    boardMask = 0;
+    for (int col = 0; col < cols; col++)
+    {
+        bottomMask |= 1ULL << (col * height);
+        boardMask |= columnMask(col);
+    }
+
+    current = 0;
+    mask = 0;
+    moves = 0;
+    return true;
+}
+
+void BitboardPosition::load(const Game &game)
+{
+    setBoardSize(game.getRows(), game.getCols());
+
+    current = 0;
+    mask = 0;
+    moves = game.getMoveCount();
+    for (int col = 0; col < cols; col++)
+    {
+        for (int h = 0; h < game.getColumnHeight(col); h++)
+        {
+            uint64_t bit = 1ULL << (col * height + h);
+            mask |= bit;
+            if (game.getCell(rows - 1 - h, col) == game.getCurrentPlayer())
+                current |= bit;
+        }
+    }
+}
+
+uint64_t BitboardPosition::possibleMoves() const
+{
+    return (mask + bottomMask) & boardMask;
+}
+
+uint64_t BitboardPosition::columnMask(int col) const
+{
+    return ((1ULL << rows) - 1) << (col * height);
+}
+
+// Pole, na które spadnie pionek w kolumnie col (od 0); 0, gdy jest pełna.
+uint64_t BitboardPosition::columnMove(int col) const
+{
+    return possibleMoves() & columnMask(col);
+}
+
+// i-ta kolumna od środka; tania arytmetyka, więc bez tablicy w pozycji.
+int BitboardPosition::orderedColumn(int i) const
+{
+    return centerOutColumn(cols, i);
+}
+
+uint64_t BitboardPosition::winningCells() const
+{
+    return winningCells(current);
+}
+
+uint64_t BitboardPosition::opponentWinningCells() const
+{
+    return winningCells(current ^ mask);
+}
+
+bool BitboardPosition::isWinningMove(uint64_t move) const
+{
+    return winningCells(current) & move;
+}
+
+bool BitboardPosition::canWinNext() const
+{
+    return winningCells(current) & possibleMoves();
+}
+
+// Ruchy, po których rywal nie wygrywa od razu. Gdy rywal ma pole
+// wygrywające, jedynym ruchem jest jego zajęcie (dwa takie pola = przegrana).
+uint64_t BitboardPosition::nonLosingMoves() const
+{
+    uint64_t possible = possibleMoves();
+    uint64_t opponentWins = winningCells(current ^ mask);
+    uint64_t forced = possible & opponentWins;
+    if (forced)
+    {
+        if (forced & (forced - 1))
+            return 0;
+        possible = forced;
+    }
+    // nie gramy pod polem wygrywającym rywala
+    return possible & ~(opponentWins >> 1);
+}
+
+// Liczba wolnych pól wygrywających gracza na ruchu po ruchu move.
+int BitboardPosition::threatsAfter(uint64_t move) const
+{
+    return __builtin_popcountll(winningCells(current | move) & ~move);
+}
+
+// Po ruchu pionki gracza na ruchu to pionki rywala sprzed ruchu.
+void BitboardPosition::play(uint64_t move)
+{
+    current ^= mask;
+    mask |= move;
+    moves++;
+}
+
+// Cofa play(move) - move musi być ostatnim zagranym ruchem.
+void BitboardPosition::undo(uint64_t move)
+{
+    mask ^= move;
+    current ^= mask;
+    moves--;
+}
+
+bool BitboardPosition::isSymmetric() const
+{
+    return mirror(mask) == mask && mirror(current) == current;
+}
+
+// current + mask jednoznacznie opisuje pozycję; z niej i z jej odbicia
+// bierzemy mniejszą. Mnożenie przez liczbę nieparzystą zachowuje
+// jednoznaczność i rozrzuca indeksy w tablicy.
+uint64_t BitboardPosition::key() const
+{
+    uint64_t position = current + mask;
+    return min(position, mirror(position)) * 0x9E3779B97F4A7C15ULL;
+}
+
+bool BitboardPosition::samePosition(const BitboardPosition &other) const
+{
+    return rows == other.rows && cols == other.cols && current == other.current && mask == other.mask;
+}
+
+int BitboardPosition::getRows() const
+{
+    return rows;
+}
+
+int BitboardPosition::getCols() const
+{
+    return cols;
+}
+
+int BitboardPosition::getCells() const
+{
+    return cells;
+}
+
+int BitboardPosition::getMoveCount() const
+{
+    return moves;
+}
+
+// Wolne pola, które domykają czwórkę z pionkami pieces.
+uint64_t BitboardPosition::winningCells(uint64_t pieces) const
+{
+    return threatCells(pieces, height) & (boardMask ^ mask);
+}
+
+// Kolumny w odwrotnej kolejności. Dodawanie nie przenosi bitów między
+// kolumnami, więc mirror(current + mask) == mirror(current) + mirror(mask).
+uint64_t BitboardPosition::mirror(uint64_t bits) const
+{
+    uint64_t columnBits = (1ULL << height) - 1;
+    uint64_t mirrored = 0;
+    for (int col = 0; col < cols; col++)
+        mirrored |= ((bits >> (col * height)) & columnBits) << ((cols - 1 - col) * height);
+    return mirrored;
+}
@@ -3,13 +3,23 @@
 #include <vector>
 #include <string>
 #include <algorithm>
+#include <memory>
 #include "Game.h"
 #include "Move.h"
+#include "WindowTable.h"
+#include "PatternKernel.h"
+#include "WindowCounters.h"
 
 using namespace std;
 
-class ConnectFour : public Game
+class ConnectFour final : public Game
 {
+private:
+    shared_ptr<const WindowTable> windowTable;
+    shared_ptr<const PatternKernel> patternKernel; // pusty, gdy plansza nie mieści się w masce
+    // stan oceny przyrostowej, aktualizowany w addMove/undoMove
+    WindowCounters<WindowTableView> counters;
+
 public:
     ConnectFour(int rows, int cols);
     ConnectFour(int rows, int cols, char currentPlayer);
@@ -20,23 +30,52 @@ public:
     vector<int> getValidMoves() const override;
     bool makeMove(int column) override;
     bool assumeMove(int column, char player);
+    void addMove(Move move) override;
+    void undoMove() override;
+    void reset() override;
     void checkIsGameOver() override;
     bool checkWin(char player) const override;
     void calculateEval() override;
     int evaluate(char player) const override;
+    uint64_t winningColumns(char player) const override;
+    void evalDeltas(char player, int *deltas) const override;
     bool canWinNextMove(char player) const;
     int countOpenThrees(char player) const;
     int countOpenTwos(char player) const;
+
+private:
+    static int playerIndex(char player);
+
+    PatternCounts countPatterns() const;
+    int incrementalEvaluate(char player) const;
+
+protected:
+    void refreshEval() const override;
 };
 
 ConnectFour::ConnectFour(int rows, int cols)
-    : Game(rows, cols) {}
+    : Game(rows, cols),
+      windowTable(make_shared<WindowTable>(getRows(), getCols())),
+      counters(WindowTableView{windowTable.get()})
+{
+    if (PatternKernel::fits(getRows(), getCols()))
+        patternKernel = make_shared<PatternKernel>(getRows(), getCols());
+}
 
 ConnectFour::ConnectFour(int rows, int cols, char currentPlayer)
-    : Game(rows, cols, currentPlayer) {}
+    : Game(rows, cols, currentPlayer),
+      windowTable(make_shared<WindowTable>(getRows(), getCols())),
+      counters(WindowTableView{windowTable.get()})
+{
+    if (PatternKernel::fits(getRows(), getCols()))
+        patternKernel = make_shared<PatternKernel>(getRows(), getCols());
+}
 
 ConnectFour::ConnectFour(const ConnectFour &other)
-    : Game(other)
+    : Game(other),
+      windowTable(other.windowTable),
+      patternKernel(other.patternKernel),
+      counters(other.counters)
 {
 }
 
@@ -50,8 +89,15 @@ ConnectFour &ConnectFour::operator=(const ConnectFour &other)
         moveHistory = other.moveHistory;
         evalX = other.evalX;
         evalO = other.evalO;
+        evalDirty = other.evalDirty;
         winner = other.winner;
+        hash = other.hash;
+        mirrorHash = other.mirrorHash;
         board = other.board;
+        heights = other.heights;
+        windowTable = other.windowTable;
+        patternKernel = other.patternKernel;
+        counters = other.counters;
     }
     return *this;
 }
@@ -66,7 +112,7 @@ vector<int> ConnectFour::getValidMoves() const
     vector<int> validMoves;
     for (int col = 0; col < getCols(); col++)
     {
-        if (board[0][col] == ' ')
+        if (heights[col] < getRows())
         {
             validMoves.push_back(col + 1);
         }
@@ -84,23 +130,14 @@ bool ConnectFour::makeMove(int column)
 
     int colIndex = column - 1;
 
-    if (board[0][colIndex] != ' ')
+    if (heights[colIndex] == getRows())
     {
         printf("Kolumna %d jest już pełna!", column);
         return false;
     }
 
-    for (int row = getRows() - 1; row >= 0; --row)
-    {
-        if (board[row][colIndex] == ' ')
-        {
-            addMove(Move{row, colIndex, getCurrentPlayer()});
-            calculateEval();
-            return true;
-        }
-    }
-
-    return false;
+    addMove(Move{getRows() - 1 - heights[colIndex], colIndex, getCurrentPlayer()});
+    return true;
 }
 
 bool ConnectFour::assumeMove(int column, char player)
@@ -113,396 +150,126 @@ bool ConnectFour::assumeMove(int column, char player)
 
     int colIndex = column - 1;
 
-    if (board[0][colIndex] != ' ')
+    if (heights[colIndex] == getRows())
     {
         return false;
     }
 
-    for (int row = getRows() - 1; row >= 0; --row)
-    {
-        if (board[row][colIndex] == ' ')
-        {
-            addMove(Move{row, colIndex, player});
-            return true;
-        }
-    }
+    addMove(Move{getRows() - 1 - heights[colIndex], colIndex, player});
+    return true;
+}
 
-    return false;
+void ConnectFour::addMove(Move move)
+{
+    counters.update(*this, move, 1);
+    Game::addMove(move);
+}
+
+void ConnectFour::undoMove()
+{
+    counters.update(*this, moveHistory.back(), -1);
+    Game::undoMove();
+}
+
+void ConnectFour::reset()
+{
+    Game::reset();
+    counters.clear();
 }
 
 void ConnectFour::checkIsGameOver()
 {
-    if (checkWin('X'))
-        setWinner('X');
-    else if (checkWin('O'))
-        setWinner('O');
+    if (isLastMoveWin())
+        setWinner(moveHistory.back().player);
     else if (getMoveCount() == getMaxMoves())
         setWinner('D');
 }
 
 bool ConnectFour::checkWin(char player) const
 {
-    int rows = getRows();
-    int cols = getCols();
-
-    // horizontal
-    for (int r = 0; r < rows; ++r)
-        for (int c = 0; c < cols - 3; ++c)
-            if (board[r][c] == player &&
-                board[r][c + 1] == player &&
-                board[r][c + 2] == player &&
-                board[r][c + 3] == player)
-                return true;
-
-    // vertical
-    for (int r = 0; r < rows - 3; ++r)
-        for (int c = 0; c < cols; ++c)
-            if (board[r][c] == player &&
-                board[r + 1][c] == player &&
-                board[r + 2][c] == player &&
-                board[r + 3][c] == player)
-                return true;
-
-    // diag down-right
-    for (int r = 0; r < rows - 3; ++r)
-        for (int c = 0; c < cols - 3; ++c)
-            if (board[r][c] == player &&
-                board[r + 1][c + 1] == player &&
-                board[r + 2][c + 2] == player &&
-                board[r + 3][c + 3] == player)
-                return true;
-
-    // diag up-right
-    for (int r = 3; r < rows; ++r)
-        for (int c = 0; c < cols - 3; ++c)
-            if (board[r][c] == player &&
-                board[r - 1][c + 1] == player &&
-                board[r - 2][c + 2] == player &&
-                board[r - 3][c + 3] == player)
-                return true;
-
+    for (const Window &window : windowTable->windows)
+    {
+        if (board[window.cell[0]] == player &&
+            board[window.cell[1]] == player &&
+            board[window.cell[2]] == player &&
+            board[window.cell[3]] == player)
+            return true;
+    }
     return false;
 }
 
-void ConnectFour::calculateEval()
+int ConnectFour::playerIndex(char player)
 {
-    evalX = evaluate('X');
-    evalO = evaluate('O');
+    return player == 'X' ? 0 : 1;
 }
 
-int ConnectFour::evaluate(char player) const
+// Z liczników przyrostowych: pole na szczycie kolumny domyka jakieś okno.
+uint64_t ConnectFour::winningColumns(char player) const
 {
-    char opponent = (player == 'X') ? 'O' : 'X';
-
-    if (checkWin(player))
-        return 1000000;
-    if (checkWin(opponent))
-        return -1000000;
+    return counters.winningColumns(*this, playerIndex(player));
+}
 
-    int score = 0;
+// To samo co evaluate(), ale z sum utrzymywanych przyrostowo.
+int ConnectFour::incrementalEvaluate(char player) const
+{
+    return scorePatterns(counters.counts(*this), playerIndex(player));
+}
 
-    if (canWinNextMove(player))
-        score += 100000;
-    if (canWinNextMove(opponent))
-        score -= 150000;
+void ConnectFour::evalDeltas(char player, int *deltas) const
+{
+    counters.evalDeltas(*this, player, deltas);
+}
 
-    score += countOpenThrees(player) * 50000;
-    score -= countOpenThrees(opponent) * 75000;
+void ConnectFour::calculateEval()
+{
+    evalX = evaluate('X');
+    evalO = evaluate('O');
+    evalDirty = false;
+}
 
-    score += countOpenTwos(player) * 1000;
-    score -= countOpenTwos(opponent) * 1500;
+void ConnectFour::refreshEval() const
+{
+    evalX = incrementalEvaluate('X');
+    evalO = incrementalEvaluate('O');
+}
 
-    for (int row = 0; row < rows; row++)
-    {
-        if (board[row][3] == player)
-            score += 100;
-        if (board[row][3] == opponent)
-            score -= 100;
-    }
+// Pełne przeliczenie niezależne od stanu przyrostowego.
+int ConnectFour::evaluate(char player) const
+{
+    return scorePatterns(countPatterns(), playerIndex(player));
+}
 
-    return score;
+// Wzorce z całej planszy: wektorowo, gdy plansza mieści się w masce
+// 64-bitowej, a w przeciwnym razie jednym przejściem po wszystkich oknach.
+// Kolumny wygrywające też liczone od nowa, nie z liczników przyrostowych.
+PatternCounts ConnectFour::countPatterns() const
+{
+    if (patternKernel)
+        return patternKernel->count(board.data());
+    return counters.countAll(*this, board.data());
 }
 
 bool ConnectFour::canWinNextMove(char player) const
 {
-    auto moves = getValidMoves();
-
-    auto gameCopy = clone();
-    for (int move : moves)
-    {
-        if (gameCopy->assumeMove(move, player))
-        {
-            if (gameCopy->checkWin(player))
-            {
-                return true;
-            }
-            gameCopy->undoMove();
-            continue;
-        }
-    }
-
-    return false;
+    return winningColumns(player) != 0;
 }
 
 int ConnectFour::countOpenThrees(char player) const
 {
+    int me = playerIndex(player);
     int count = 0;
-
-    // horizontal
-    for (int r = 0; r < rows; ++r)
-    {
-        for (int c = 0; c < cols - 3; ++c)
-        {
-            // XXX _
-            if (board[r][c] == player &&
-                board[r][c + 1] == player &&
-                board[r][c + 2] == player &&
-                board[r][c + 3] == ' ')
-            {
-                count++;
-            }
-            // XX _ X
-            if (board[r][c] == player &&
-                board[r][c + 1] == player &&
-                board[r][c + 2] == ' ' &&
-                board[r][c + 3] == player)
-            {
-                count++;
-            }
-            // X _ XX
-            if (board[r][c] == player &&
-                board[r][c + 1] == ' ' &&
-                board[r][c + 2] == player &&
-                board[r][c + 3] == player)
-            {
-                count++;
-            }
-            // _ XXX
-            if (board[r][c] == ' ' &&
-                board[r][c + 1] == player &&
-                board[r][c + 2] == player &&
-                board[r][c + 3] == player)
-            {
-                count++;
-            }
-        }
-    }
-
-    // vertical - XXX_
-    for (int r = 0; r < rows - 3; ++r)
-    {
-        for (int c = 0; c < cols; ++c)
-        {
-            if (board[r][c] == player &&
-                board[r + 1][c] == player &&
-                board[r + 2][c] == player &&
-                board[r + 3][c] == ' ')
-            {
-                count++;
-            }
-        }
-    }
-
-    // diag down-right
-    for (int r = 0; r < rows - 3; ++r)
-    {
-        for (int c = 0; c < cols - 3; ++c)
-        {
-            // XXX _
-            if (board[r][c] == player &&
-                board[r + 1][c + 1] == player &&
-                board[r + 2][c + 2] == player &&
-                board[r + 3][c + 3] == ' ')
-            {
-                count++;
-            }
-            // XX _ X
-            if (board[r][c] == player &&
-                board[r + 1][c + 1] == player &&
-                board[r + 2][c + 2] == ' ' &&
-                board[r + 3][c + 3] == player)
-            {
-                count++;
-            }
-            // X _ XX
-            if (board[r][c] == player &&
-                board[r + 1][c + 1] == ' ' &&
-                board[r + 2][c + 2] == player &&
-                board[r + 3][c + 3] == player)
-            {
-                count++;
-            }
-            // _ XXX
-            if (board[r][c] == ' ' &&
-                board[r + 1][c + 1] == player &&
-                board[r + 2][c + 2] == player &&
-                board[r + 3][c + 3] == player)
-            {
-                count++;
-            }
-        }
-    }
-
-    // diag up-right
-    for (int r = 3; r < rows; ++r)
-    {
-        for (int c = 0; c < cols - 3; ++c)
-        {
-            // XXX _
-            if (board[r][c] == player &&
-                board[r - 1][c + 1] == player &&
-                board[r - 2][c + 2] == player &&
-                board[r - 3][c + 3] == ' ')
-            {
-                count++;
-            }
-            // XX _ X
-            if (board[r][c] == player &&
-                board[r - 1][c + 1] == player &&
-                board[r - 2][c + 2] == ' ' &&
-                board[r - 3][c + 3] == player)
-            {
-                count++;
-            }
-            // X _ XX
-            if (board[r][c] == player &&
-                board[r - 1][c + 1] == ' ' &&
-                board[r - 2][c + 2] == player &&
-                board[r - 3][c + 3] == player)
-            {
-                count++;
-            }
-            // _ XXX
-            if (board[r][c] == ' ' &&
-                board[r - 1][c + 1] == player &&
-                board[r - 2][c + 2] == player &&
-                board[r - 3][c + 3] == player)
-            {
-                count++;
-            }
-        }
-    }
-
+    const WindowPattern *patterns = WindowTable::patterns();
+    for (const Window &window : windowTable->windows)
+        count += patterns[window.direction * 81 + WindowTable::windowCode(board.data(), window)].threes[me];
     return count;
 }
 
 int ConnectFour::countOpenTwos(char player) const
 {
+    int me = playerIndex(player);
     int count = 0;
-    // horizontal
-    for (int r = 0; r < rows; ++r)
-        for (int c = 0; c < cols - 3; ++c)
-        {
-            // XX _ _
-            if (board[r][c] == player &&
-                board[r][c + 1] == player &&
-                board[r][c + 2] == ' ' &&
-                board[r][c + 3] == ' ')
-            {
-                count++;
-            }
-            // _ XX _
-            if (board[r][c] == ' ' &&
-                board[r][c + 1] == player &&
-                board[r][c + 2] == player &&
-                board[r][c + 3] == ' ')
-            {
-                count++;
-            }
-            // _ _ XX
-            if (board[r][c] == ' ' &&
-                board[r][c + 1] == ' ' &&
-                board[r][c + 2] == player &&
-                board[r][c + 3] == player)
-            {
-                count++;
-            }
-            // X _ X _
-            if (board[r][c] == player &&
-                board[r][c + 1] == ' ' &&
-                board[r][c + 2] == player &&
-                board[r][c + 3] == ' ')
-            {
-                count++;
-            }
-            // X _ _ X
-            if (board[r][c] == player &&
-                board[r][c + 1] == ' ' &&
-                board[r][c + 2] == ' ' &&
-                board[r][c + 3] == player)
-            {
-                count++;
-            }
-        }
-
-    // vertical - XX__
-    for (int r = 0; r < rows - 3; ++r)
-        for (int c = 0; c < cols; ++c)
-            if (board[r][c] == player &&
-                board[r + 1][c] == player &&
-                board[r + 2][c] == ' ' &&
-                board[r + 3][c] == ' ')
-                count++;
-
-    // diag down-right
-    for (int r = 0; r < rows - 3; ++r)
-        for (int c = 0; c < cols - 3; ++c)
-        {
-            // XX _ _
-            if (board[r][c] == player &&
-                board[r + 1][c + 1] == player &&
-                board[r + 2][c + 2] == ' ' &&
-                board[r + 3][c + 3] == ' ')
-            {
-                count++;
-            }
-            // _ XX _
-            if (board[r][c] == ' ' &&
-                board[r + 1][c + 1] == player &&
-                board[r + 2][c + 2] == player &&
-                board[r + 3][c + 3] == ' ')
-            {
-                count++;
-            }
-            // _ _ XX
-            if (board[r][c] == ' ' &&
-                board[r + 1][c + 1] == ' ' &&
-                board[r + 2][c + 2] == player &&
-                board[r + 3][c + 3] == player)
-            {
-                count++;
-            }
-        }
-
-    // diag up-right
-    for (int r = 3; r < rows; ++r)
-        for (int c = 0; c < cols - 3; ++c)
-        {
-            // XX _ _
-            if (board[r][c] == player &&
-                board[r - 1][c + 1] == player &&
-                board[r - 2][c + 2] == ' ' &&
-                board[r - 3][c + 3] == ' ')
-            {
-                count++;
-            }
-            // _ XX _
-            if (board[r][c] == ' ' &&
-                board[r - 1][c + 1] == player &&
-                board[r - 2][c + 2] == player &&
-                board[r - 3][c + 3] == ' ')
-            {
-                count++;
-            }
-            // _ _ XX
-            if (board[r][c] == ' ' &&
-                board[r - 1][c + 1] == ' ' &&
-                board[r - 2][c + 2] == player &&
-                board[r - 3][c + 3] == player)
-            {
-                count++;
-            }
-        }
-
+    const WindowPattern *patterns = WindowTable::patterns();
+    for (const Window &window : windowTable->windows)
+        count += patterns[window.direction * 81 + WindowTable::windowCode(board.data(), window)].twos[me];
     return count;
 }
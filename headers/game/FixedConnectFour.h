@@ -0,0 +1,386 @@
+#pragma once
+#include <iostream>
+#include <vector>
+#include <array>
+#include <memory>
+#include "Game.h"
+#include "Move.h"
+#include "WindowTable.h"
+#include "WindowCounters.h"
+#include "ConnectFour.h"
+
+using namespace std;
+
+constexpr int fixedWindowCount(int rows, int cols)
+{
+    return rows * (cols - 3) + (rows - 3) * cols + 2 * (rows - 3) * (cols - 3);
+}
+
+// Wszystkie okna planszy w tej samej kolejności co WindowTable, liczone
+// w czasie kompilacji.
+template <int Rows, int Cols>
+constexpr array<Window, fixedWindowCount(Rows, Cols)> buildFixedWindows()
+{
+    array<Window, fixedWindowCount(Rows, Cols)> windows{};
+    int count = 0;
+
+    const int starts[4][2] = {{0, 0}, {0, 0}, {0, 0}, {3, 0}};
+    const int ends[4][2] = {{Rows, Cols - 3}, {Rows - 3, Cols}, {Rows - 3, Cols - 3}, {Rows, Cols - 3}};
+    const int steps[4][2] = {{0, 1}, {1, 0}, {1, 1}, {-1, 1}};
+    const WindowDirection directions[4] = {HORIZONTAL, VERTICAL, DIAG_DOWN, DIAG_UP};
+
+    for (int d = 0; d < 4; d++)
+    {
+        for (int r = starts[d][0]; r < ends[d][0]; ++r)
+        {
+            for (int c = starts[d][1]; c < ends[d][1]; ++c)
+            {
+                Window &window = windows[count++];
+                window.direction = directions[d];
+                for (int i = 0; i < 4; i++)
+                {
+                    window.row[i] = r + i * steps[d][0];
+                    window.col[i] = c + i * steps[d][1];
+                    window.cell[i] = window.row[i] * Cols + window.col[i];
+                }
+            }
+        }
+    }
+    return windows;
+}
+
+template <int Rows, int Cols>
+constexpr array<CellWindows, Rows * Cols> buildFixedCellWindows()
+{
+    array<CellWindows, Rows * Cols> cells{};
+    array<Window, fixedWindowCount(Rows, Cols)> windows = buildFixedWindows<Rows, Cols>();
+
+    for (int w = 0; w < (int)windows.size(); w++)
+    {
+        for (int i = 0; i < 4; i++)
+        {
+            CellWindows &cell = cells[windows[w].cell[i]];
+            cell.slots[cell.count++] = WindowSlot{w, i};
+        }
+    }
+    return cells;
+}
+
+// Tabele okien dla WindowCounters w FixedConnectFour: stałe constexpr,
+// a stan przyrostowy w tablicach o stałym rozmiarze.
+template <int Rows, int Cols>
+struct FixedWindowTables
+{
+    static constexpr int CELLS = Rows * Cols;
+    static constexpr int WINDOW_COUNT = fixedWindowCount(Rows, Cols);
+    static constexpr array<Window, WINDOW_COUNT> WINDOWS = buildFixedWindows<Rows, Cols>();
+    static constexpr array<CellWindows, CELLS> CELL_WINDOWS = buildFixedCellWindows<Rows, Cols>();
+
+    using Codes = array<uint8_t, WINDOW_COUNT>;
+    using Threats = array<uint8_t, 2 * CELLS>;
+
+    int rows() const;
+    int cols() const;
+    int windowCount() const;
+    const Window &window(int index) const;
+    const CellWindows &cellWindows(int cell) const;
+    Codes emptyCodes() const;
+    Threats emptyThreats() const;
+};
+
+template <int Rows, int Cols>
+int FixedWindowTables<Rows, Cols>::rows() const
+{
+    return Rows;
+}
+
+template <int Rows, int Cols>
+int FixedWindowTables<Rows, Cols>::cols() const
+{
+    return Cols;
+}
+
+template <int Rows, int Cols>
+int FixedWindowTables<Rows, Cols>::windowCount() const
+{
+    return WINDOW_COUNT;
+}
+
+template <int Rows, int Cols>
+const Window &FixedWindowTables<Rows, Cols>::window(int index) const
+{
+    return WINDOWS[index];
+}
+
+template <int Rows, int Cols>
+const CellWindows &FixedWindowTables<Rows, Cols>::cellWindows(int cell) const
+{
+    return CELL_WINDOWS[cell];
+}
+
+template <int Rows, int Cols>
+typename FixedWindowTables<Rows, Cols>::Codes FixedWindowTables<Rows, Cols>::emptyCodes() const
+{
+    return Codes{};
+}
+
+template <int Rows, int Cols>
+typename FixedWindowTables<Rows, Cols>::Threats FixedWindowTables<Rows, Cols>::emptyThreats() const
+{
+    return Threats{};
+}
+
+// ConnectFour o wymiarach znanych w czasie kompilacji. Tabele okien są
+// stałymi constexpr, stan przyrostowy ma stały rozmiar, a pętle po oknach
+// mają stałe granice, więc kompilator może je rozwinąć. Ocena i reguły są
+// identyczne z ConnectFour (sprawdza to BackendTester).
+template <int Rows, int Cols>
+class FixedConnectFour final : public Game
+{
+    static_assert(Rows >= 4 && Cols >= 4 && Rows <= MAX_SIZE && Cols <= MAX_SIZE,
+                  "Plansza musi mieć wymiary od 4 do Game::MAX_SIZE");
+
+public:
+    using Tables = FixedWindowTables<Rows, Cols>;
+
+private:
+    WindowCounters<Tables> counters; // stan oceny przyrostowej
+
+public:
+    FixedConnectFour(char currentPlayer = 'X');
+    FixedConnectFour(const FixedConnectFour &other) = default;
+    FixedConnectFour &operator=(const FixedConnectFour &other);
+    unique_ptr<Game> clone() const override;
+
+    vector<int> getValidMoves() const override;
+    bool makeMove(int column) override;
+    bool assumeMove(int column, char player) override;
+    void addMove(Move move) override;
+    void undoMove() override;
+    void reset() override;
+    void checkIsGameOver() override;
+    bool isLastMoveWin() const override;
+    bool checkWin(char player) const override;
+    void calculateEval() override;
+    int evaluate(char player) const override;
+    uint64_t winningColumns(char player) const override;
+    void evalDeltas(char player, int *deltas) const override;
+
+private:
+    static int playerIndex(char player);
+
+    int incrementalEvaluate(char player) const;
+
+protected:
+    void refreshEval() const override;
+};
+
+using ConnectFour6x7 = FixedConnectFour<6, 7>;
+using ConnectFour7x8 = FixedConnectFour<7, 8>;
+
+// Plansza o zadanym rozmiarze: typ ze stałymi wymiarami dla 6x7 i 7x8,
+// dla pozostałych rozmiarów ConnectFour.
+unique_ptr<Game> makeConnectFour(int rows, int cols)
+{
+    if (rows == 6 && cols == 7)
+        return make_unique<ConnectFour6x7>();
+    if (rows == 7 && cols == 8)
+        return make_unique<ConnectFour7x8>();
+    return make_unique<ConnectFour>(rows, cols);
+}
+
+template <int Rows, int Cols>
+FixedConnectFour<Rows, Cols>::FixedConnectFour(char currentPlayer)
+    : Game(Rows, Cols, currentPlayer)
+{
+}
+
+template <int Rows, int Cols>
+FixedConnectFour<Rows, Cols> &FixedConnectFour<Rows, Cols>::operator=(const FixedConnectFour &other)
+{
+    if (this != &other)
+    {
+        currentPlayer = other.currentPlayer;
+        moveHistory = other.moveHistory;
+        evalX = other.evalX;
+        evalO = other.evalO;
+        evalDirty = other.evalDirty;
+        winner = other.winner;
+        hash = other.hash;
+        mirrorHash = other.mirrorHash;
+        board = other.board;
+        heights = other.heights;
+        counters = other.counters;
+    }
+    return *this;
+}
+
+template <int Rows, int Cols>
+unique_ptr<Game> FixedConnectFour<Rows, Cols>::clone() const
+{
+    return make_unique<FixedConnectFour>(*this);
+}
+
+template <int Rows, int Cols>
+vector<int> FixedConnectFour<Rows, Cols>::getValidMoves() const
+{
+    vector<int> validMoves;
+    for (int col = 0; col < Cols; col++)
+    {
+        if (heights[col] < Rows)
+        {
+            validMoves.push_back(col + 1);
+        }
+    }
+    return validMoves;
+}
+
+template <int Rows, int Cols>
+bool FixedConnectFour<Rows, Cols>::makeMove(int column)
+{
+    if (column < 1 || column > Cols)
+    {
+        printf("Nieprawidłowy numer kolumny! Wybierz od 1 do %d.", Cols);
+        return false;
+    }
+
+    int colIndex = column - 1;
+
+    if (heights[colIndex] == Rows)
+    {
+        printf("Kolumna %d jest już pełna!", column);
+        return false;
+    }
+
+    addMove(Move{Rows - 1 - heights[colIndex], colIndex, getCurrentPlayer()});
+    return true;
+}
+
+template <int Rows, int Cols>
+bool FixedConnectFour<Rows, Cols>::assumeMove(int column, char player)
+{
+    if (column < 1 || column > Cols)
+    {
+        printf("Nieprawidłowy numer kolumny! Wybierz od 1 do %d.", Cols);
+        return false;
+    }
+
+    int colIndex = column - 1;
+
+    if (heights[colIndex] == Rows)
+    {
+        return false;
+    }
+
+    addMove(Move{Rows - 1 - heights[colIndex], colIndex, player});
+    return true;
+}
+
+template <int Rows, int Cols>
+void FixedConnectFour<Rows, Cols>::addMove(Move move)
+{
+    counters.update(*this, move, 1);
+    Game::addMove(move);
+}
+
+template <int Rows, int Cols>
+void FixedConnectFour<Rows, Cols>::undoMove()
+{
+    counters.update(*this, moveHistory.back(), -1);
+    Game::undoMove();
+}
+
+template <int Rows, int Cols>
+void FixedConnectFour<Rows, Cols>::reset()
+{
+    Game::reset();
+    counters.clear();
+}
+
+template <int Rows, int Cols>
+void FixedConnectFour<Rows, Cols>::checkIsGameOver()
+{
+    if (isLastMoveWin())
+        setWinner(moveHistory.back().player);
+    else if (getMoveCount() == getMaxMoves())
+        setWinner('D');
+}
+
+// Wygrana może powstać tylko w oknie przez ostatnie pole.
+template <int Rows, int Cols>
+bool FixedConnectFour<Rows, Cols>::isLastMoveWin() const
+{
+    if (moveHistory.empty())
+        return false;
+
+    const Move &last = moveHistory.back();
+    int full = last.player == 'X' ? 40 : 80; // 1+3+9+27 razy kod gracza
+    const CellWindows &cellWindows = Tables::CELL_WINDOWS[last.row * Cols + last.column];
+    for (int i = 0; i < cellWindows.count; i++)
+    {
+        if (counters.windowCode(cellWindows.slots[i].window) == full)
+            return true;
+    }
+    return false;
+}
+
+template <int Rows, int Cols>
+bool FixedConnectFour<Rows, Cols>::checkWin(char player) const
+{
+    for (const Window &window : Tables::WINDOWS)
+    {
+        if (board[window.cell[0]] == player &&
+            board[window.cell[1]] == player &&
+            board[window.cell[2]] == player &&
+            board[window.cell[3]] == player)
+            return true;
+    }
+    return false;
+}
+
+template <int Rows, int Cols>
+int FixedConnectFour<Rows, Cols>::playerIndex(char player)
+{
+    return player == 'X' ? 0 : 1;
+}
+
+template <int Rows, int Cols>
+uint64_t FixedConnectFour<Rows, Cols>::winningColumns(char player) const
+{
+    return counters.winningColumns(*this, playerIndex(player));
+}
+
+template <int Rows, int Cols>
+int FixedConnectFour<Rows, Cols>::incrementalEvaluate(char player) const
+{
+    return scorePatterns(counters.counts(*this), playerIndex(player));
+}
+
+template <int Rows, int Cols>
+void FixedConnectFour<Rows, Cols>::evalDeltas(char player, int *deltas) const
+{
+    counters.evalDeltas(*this, player, deltas);
+}
+
+template <int Rows, int Cols>
+void FixedConnectFour<Rows, Cols>::calculateEval()
+{
+    evalX = evaluate('X');
+    evalO = evaluate('O');
+    evalDirty = false;
+}
+
+template <int Rows, int Cols>
+void FixedConnectFour<Rows, Cols>::refreshEval() const
+{
+    evalX = incrementalEvaluate('X');
+    evalO = incrementalEvaluate('O');
+}
+
+// Pełne przeliczenie jednym przejściem po stałej tabeli okien, niezależne
+// od stanu przyrostowego.
+template <int Rows, int Cols>
+int FixedConnectFour<Rows, Cols>::evaluate(char player) const
+{
+    return scorePatterns(counters.countAll(*this, board.data()), playerIndex(player));
+}
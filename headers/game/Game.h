@@ -2,21 +2,36 @@
 #include <iostream>
 #include <vector>
 #include <memory>
+#include <random>
+#include <cstdint>
+#include <climits>
 #include "Move.h"
+#include "MoveList.h"
+#include "AlignedAllocator.h"
 
 using namespace std;
 
 class Game
 {
+public:
+    static constexpr int MAX_SIZE = MoveList::CAPACITY;
+
 protected:
     int rows;
     int cols;
-    vector<vector<char>> board;
+    vector<char, AlignedAllocator<char>> board; // wiersz po wierszu: row * cols + col
+    vector<uint8_t> heights;                    // liczba pionków w każdej kolumnie
     vector<Move> moveHistory;
     char currentPlayer;
-    int evalX = 0;
-    int evalO = 0;
+    // Ocena liczona leniwie: ruch tylko ją unieważnia (evalDirty), a getEval
+    // przelicza ją przy pierwszym odczycie. Węzły wewnętrzne przeszukiwania
+    // oceny nie czytają, więc nie płacą za nią.
+    mutable int evalX = 0;
+    mutable int evalO = 0;
+    mutable bool evalDirty = false;
     char winner = '\0';
+    uint64_t hash = 0;
+    uint64_t mirrorHash = 0; // hash pozycji odbitej lewo-prawo
 
 public:
     Game(int rows, int cols, char currentPlayer = 'X');
@@ -26,8 +41,8 @@ public:
 
     void setCurrentPlayer(char player);
     char getCurrentPlayer() const;
-    void addMove(Move move);
-    void undoMove();
+    virtual void addMove(Move move);
+    virtual void undoMove();
     int getMoveCount() const;
     int getMaxMoves() const;
     void printBoard() const;
@@ -38,7 +53,23 @@ public:
     char getWinner() const;
     int getRows() const;
     int getCols() const;
-    void reset();
+    char getCell(int row, int col) const;
+    int getColumnHeight(int col) const;
+    bool isCenterColumn(int col) const;
+    uint64_t getHash() const;
+    uint64_t getMirrorHash() const;
+    uint64_t getCanonicalHash() const;
+    bool isMirrored() const;
+    bool isSymmetric() const;
+    int mirrorMove(int move) const;
+    int canonicalMove(int move) const;
+    void generateMoves(MoveList &moves) const;
+    void generateDistinctMoves(MoveList &moves) const;
+    virtual void reset();
+    virtual bool isLastMoveWin() const;
+    virtual uint64_t winningColumns(char player) const;
+    virtual void evalDeltas(char player, int *deltas) const;
+    bool isTerminal() const;
 
     virtual vector<int> getValidMoves() const = 0;
     virtual bool makeMove(int column) = 0;
@@ -48,6 +79,12 @@ public:
     virtual void calculateEval() = 0;
     virtual int evaluate(char player) const = 0;
     virtual unique_ptr<Game> clone() const = 0;
+
+protected:
+    virtual void refreshEval() const;
+    bool completesLine(int row, int col, char player) const;
+    static uint64_t zobristKey(int cell, char player);
+    static uint64_t sideKey();
 };
 
 Game::Game(int rows, int cols, char player)
@@ -55,24 +92,31 @@ Game::Game(int rows, int cols, char player)
       cols(cols),
       currentPlayer(player)
 {
-    if (rows < 4 || cols < 4)
+    hash = (currentPlayer == 'O') ? sideKey() : 0;
+    mirrorHash = hash;
+    if (rows < 4 || cols < 4 || rows > MAX_SIZE || cols > MAX_SIZE)
     {
-        this->rows = max(4, rows);
-        this->cols = max(4, cols);
+        this->rows = min(max(4, rows), MAX_SIZE);
+        this->cols = min(max(4, cols), MAX_SIZE);
     }
 
-    board.resize(this->rows, vector<char>(this->cols, ' '));
+    board.assign(this->rows * this->cols, ' ');
+    heights.assign(this->cols, 0);
 }
 
 Game::Game(const Game &other)
     : rows(other.rows),
       cols(other.cols),
       board(other.board),
+      heights(other.heights),
       currentPlayer(other.currentPlayer),
       moveHistory(other.moveHistory),
       evalX(other.evalX),
       evalO(other.evalO),
-      winner(other.winner)
+      evalDirty(other.evalDirty),
+      winner(other.winner),
+      hash(other.hash),
+      mirrorHash(other.mirrorHash)
 {
 }
 
@@ -83,11 +127,15 @@ Game &Game::operator=(const Game &other)
         rows = other.rows;
         cols = other.cols;
         board = other.board;
+        heights = other.heights;
         currentPlayer = other.currentPlayer;
         moveHistory = other.moveHistory;
         evalX = other.evalX;
         evalO = other.evalO;
+        evalDirty = other.evalDirty;
         winner = other.winner;
+        hash = other.hash;
+        mirrorHash = other.mirrorHash;
     }
     printf("Game copy assignment called\n");
     return *this;
@@ -95,6 +143,11 @@ Game &Game::operator=(const Game &other)
 
 void Game::setCurrentPlayer(char player)
 {
+    if (player != currentPlayer)
+    {
+        hash ^= sideKey();
+        mirrorHash ^= sideKey();
+    }
     currentPlayer = player;
 }
 
@@ -105,17 +158,25 @@ char Game::getCurrentPlayer() const
 
 void Game::addMove(Move move)
 {
-    board[move.row][move.column] = move.player;
+    board[move.row * cols + move.column] = move.player;
+    heights[move.column]++;
+    hash ^= zobristKey(move.row * cols + move.column, move.player);
+    mirrorHash ^= zobristKey(move.row * cols + cols - 1 - move.column, move.player);
     moveHistory.push_back(move);
     setCurrentPlayer(currentPlayer == 'X' ? 'O' : 'X');
+    evalDirty = true;
 }
 
 void Game::undoMove()
 {
     Move move = moveHistory.back();
     moveHistory.pop_back();
-    board[move.row][move.column] = ' ';
+    board[move.row * cols + move.column] = ' ';
+    heights[move.column]--;
+    hash ^= zobristKey(move.row * cols + move.column, move.player);
+    mirrorHash ^= zobristKey(move.row * cols + cols - 1 - move.column, move.player);
     setCurrentPlayer(currentPlayer == 'X' ? 'O' : 'X');
+    evalDirty = true;
 }
 
 int Game::getMoveCount() const
@@ -130,6 +191,12 @@ int Game::getMaxMoves() const
 
 int Game::getEval(char player) const
 {
+    if (evalDirty)
+    {
+        refreshEval();
+        evalDirty = false;
+    }
+
     if (player == 'X')
         return evalX;
     if (player == 'O')
@@ -157,6 +224,129 @@ int Game::getCols() const
     return cols;
 }
 
+char Game::getCell(int row, int col) const
+{
+    return board[row * cols + col];
+}
+
+int Game::getColumnHeight(int col) const
+{
+    return heights[col];
+}
+
+// Środkowa kolumna (od 0), a przy parzystej liczbie kolumn obie środkowe -
+// tak, żeby premia za środek nie psuła symetrii lewo-prawo.
+bool Game::isCenterColumn(int col) const
+{
+    return col == cols / 2 || col == (cols - 1) / 2;
+}
+
+// Hash Zobrista pozycji: XOR kluczy zajętych pól i klucza strony na ruchu,
+// gdy ruch ma O. Zależy tylko od pozycji, więc zgadza się między klonami.
+uint64_t Game::getHash() const
+{
+    return hash;
+}
+
+// Hash tej samej pozycji odbitej względem środkowej kolumny.
+uint64_t Game::getMirrorHash() const
+{
+    return mirrorHash;
+}
+
+// Mniejszy z hashy pozycji i jej odbicia - pozycja i jej lustro mają ten
+// sam klucz, więc tablice i księgi trzymają je w jednym wpisie. Ruchy
+// zapisane przy kluczu są w orientacji kanonicznej (patrz canonicalMove).
+uint64_t Game::getCanonicalHash() const
+{
+    return min(hash, mirrorHash);
+}
+
+// true, gdy orientacją kanoniczną jest odbicie tej pozycji.
+bool Game::isMirrored() const
+{
+    return mirrorHash < hash;
+}
+
+// Pozycja równa swojemu odbiciu (np. pusta plansza); porównuje pola, nie hashe.
+bool Game::isSymmetric() const
+{
+    if (hash != mirrorHash)
+        return false;
+    for (int row = 0; row < rows; row++)
+    {
+        for (int col = 0; col < cols / 2; col++)
+        {
+            if (board[row * cols + col] != board[row * cols + cols - 1 - col])
+                return false;
+        }
+    }
+    return true;
+}
+
+// Kolumna (od 1) odbita względem środka planszy.
+int Game::mirrorMove(int move) const
+{
+    return cols + 1 - move;
+}
+
+// Przekłada ruch między orientacją tej pozycji a kanoniczną - w obie strony,
+// bo odbicie jest swoją odwrotnością. 0 (brak ruchu) zostaje bez zmian.
+int Game::canonicalMove(int move) const
+{
+    return (move > 0 && isMirrored()) ? mirrorMove(move) : move;
+}
+
+uint64_t Game::zobristKey(int cell, char player)
+{
+    // stałe ziarno - te same klucze w każdym uruchomieniu i dla każdej planszy
+    static const vector<uint64_t> keys = []()
+    {
+        mt19937_64 keyGen(0x5eed5eed5eedULL);
+        vector<uint64_t> table(MAX_SIZE * MAX_SIZE * 2);
+        for (uint64_t &key : table)
+            key = keyGen();
+        return table;
+    }();
+
+    return keys[cell * 2 + (player == 'X' ? 0 : 1)];
+}
+
+uint64_t Game::sideKey()
+{
+    static const uint64_t key = mt19937_64(0x51de51deULL)();
+    return key;
+}
+
+// Wersja getValidMoves bez alokacji: kolumny z wolnym polem, od lewej.
+void Game::generateMoves(MoveList &moves) const
+{
+    moves.clear();
+    for (int col = 0; col < cols; col++)
+    {
+        if (heights[col] < rows)
+            moves.add(col + 1);
+    }
+}
+
+// Ruchy do rozważenia w korzeniu: w pozycji symetrycznej ruch i jego
+// odbicie dają lustrzane pozycje o tej samej wartości, więc zostaje tylko
+// lewa połowa (ze środkową kolumną).
+void Game::generateDistinctMoves(MoveList &moves) const
+{
+    generateMoves(moves);
+    if (!isSymmetric())
+        return;
+
+    MoveList all = moves;
+    moves.clear();
+    for (int move : all)
+    {
+        if (move <= mirrorMove(move))
+            moves.add(move);
+    }
+}
+
 void Game::printBoard() const
 {
     printf("\n");
@@ -174,7 +364,7 @@ void Game::printBoard() const
         printf("|");
         for (int col = 0; col < cols; ++col)
         {
-            printf(" %c |", board[row][col]);
+            printf(" %c |", getCell(row, col));
         }
         printf("\n");
 
@@ -195,7 +385,15 @@ void Game::printBoard() const
 void Game::printEval() const
 {
     printf("\nOcena pozycji: X=%+d, O=%+d (różnica: %+d)\n",
-           evalX, evalO, evalX - evalO);
+           getEval('X'), getEval('O'), getEval('X') - getEval('O'));
+}
+
+// Domyślnie pełne przeliczenie; gry z oceną przyrostową biorą ją ze stanu
+// utrzymywanego w addMove/undoMove.
+void Game::refreshEval() const
+{
+    evalX = evaluate('X');
+    evalO = evaluate('O');
 }
 
 void Game::printMoveHistory() const
@@ -208,12 +406,95 @@ void Game::printMoveHistory() const
     }
 }
 
+// Sprawdza tylko cztery linie przechodzące przez ostatni ruch.
+bool Game::isLastMoveWin() const
+{
+    if (moveHistory.empty())
+        return false;
+
+    const Move &last = moveHistory.back();
+    return completesLine(last.row, last.column, last.player);
+}
+
+// Kolumny (bit col = kolumna col + 1), w których ruch gracza od razu daje
+// czwórkę. Bez kopiowania gry: dla wolnego pola na szczycie każdej kolumny
+// liczy pionki gracza w czterech kierunkach.
+uint64_t Game::winningColumns(char player) const
+{
+    uint64_t columns = 0;
+    for (int col = 0; col < cols; col++)
+    {
+        if (heights[col] < rows && completesLine(rows - 1 - heights[col], col, player))
+            columns |= 1ULL << col;
+    }
+    return columns;
+}
+
+// Zmiana różnicy ocen (gracz minus rywal) po ruchu gracza w każdą kolumnę:
+// deltas[col] dla kolumny col + 1, INT_MIN dla pełnych. Plansza się nie
+// zmienia; domyślnie ruchy są sprawdzane na jednej kopii gry, a gry
+// z oceną przyrostową liczą to z samych okien przez pole ruchu.
+void Game::evalDeltas(char player, int *deltas) const
+{
+    char opponent = (player == 'X') ? 'O' : 'X';
+    int before = getEval(player) - getEval(opponent);
+
+    auto gameCopy = clone();
+    for (int col = 0; col < cols; col++)
+    {
+        if (!gameCopy->assumeMove(col + 1, player))
+        {
+            deltas[col] = INT_MIN;
+            continue;
+        }
+        deltas[col] = gameCopy->getEval(player) - gameCopy->getEval(opponent) - before;
+        gameCopy->undoMove();
+    }
+}
+
+// Czy pionek gracza na polu (row, col) leżałby w linii co najmniej czterech;
+// samo pole nie jest czytane, więc może być jeszcze puste.
+bool Game::completesLine(int row, int col, char player) const
+{
+    static const int directions[4][2] = {{0, 1}, {1, 0}, {1, 1}, {1, -1}};
+
+    for (const auto &dir : directions)
+    {
+        int count = 1;
+        for (int sign : {1, -1})
+        {
+            int r = row + sign * dir[0];
+            int c = col + sign * dir[1];
+            for (int step = 0; step < 3; step++)
+            {
+                if (r < 0 || r >= rows || c < 0 || c >= cols || getCell(r, c) != player)
+                    break;
+                count++;
+                r += sign * dir[0];
+                c += sign * dir[1];
+            }
+        }
+        if (count >= 4)
+            return true;
+    }
+    return false;
+}
+
+bool Game::isTerminal() const
+{
+    return isLastMoveWin() || getMoveCount() == getMaxMoves();
+}
+
 void Game::reset()
 {
-    board = vector<vector<char>>(rows, vector<char>(cols, ' '));
+    fill(board.begin(), board.end(), ' ');
+    fill(heights.begin(), heights.end(), 0);
     currentPlayer = 'X';
+    hash = 0;
+    mirrorHash = 0;
     moveHistory.clear();
     evalX = 0;
     evalO = 0;
+    evalDirty = false;
     winner = '\0';
 }
@@ -1,12 +1,19 @@
 #pragma once
 #include <iostream>
 #include <chrono>
+#include <cstdint>
 
 using namespace std;
 
+// Plansza ma najwyżej Game::MAX_SIZE wierszy i kolumn, więc współrzędne
+// mieszczą się w bajcie, a cały ruch zajmuje 3 bajty.
 struct Move
 {
-    int row;
-    int column;
+    uint8_t row;
+    uint8_t column;
     char player;
+
+    Move() = default;
+    Move(int row, int column, char player)
+        : row(row), column(column), player(player) {}
 };
@@ -0,0 +1,75 @@
+#pragma once
+#include <iostream>
+#include <cstdint>
+#include <algorithm>
+
+using namespace std;
+
+// Lista ruchów (numery kolumn od 1) o stałej pojemności, trzymana w całości
+// na stosie - generowanie ruchów w przeszukiwaniu nie alokuje pamięci.
+class MoveList
+{
+public:
+    static constexpr int CAPACITY = 64;
+
+private:
+    uint8_t moves[CAPACITY];
+    int count = 0;
+
+public:
+    void add(int move);
+    void clear();
+    int size() const;
+    bool empty() const;
+    bool contains(int move) const;
+    int operator[](int index) const;
+    void swap(int i, int j);
+
+    const uint8_t *begin() const;
+    const uint8_t *end() const;
+};
+
+void MoveList::add(int move)
+{
+    moves[count++] = move;
+}
+
+void MoveList::clear()
+{
+    count = 0;
+}
+
+int MoveList::size() const
+{
+    return count;
+}
+
+bool MoveList::empty() const
+{
+    return count == 0;
+}
+
+bool MoveList::contains(int move) const
+{
+    return find(begin(), end(), move) != end();
+}
+
+int MoveList::operator[](int index) const
+{
+    return moves[index];
+}
+
+void MoveList::swap(int i, int j)
+{
+    std::swap(moves[i], moves[j]);
+}
+
+const uint8_t *MoveList::begin() const
+{
+    return moves;
+}
+
+const uint8_t *MoveList::end() const
+{
+    return moves + count;
+}
@@ -0,0 +1,439 @@
+#pragma once
+#include <iostream>
+#include <vector>
+#include <string>
+#include <cstdint>
+#include "WindowTable.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define PATTERN_KERNEL_X86 1
+#endif
+
+using namespace std;
+
+// Liczby wzorców z całej planszy, osobno dla X (indeks 0) i O (indeks 1).
+struct PatternCounts
+{
+    int fours[2] = {0, 0};
+    int threes[2] = {0, 0};
+    int twos[2] = {0, 0};
+    int center[2] = {0, 0}; // pionki w środkowej kolumnie (Game::isCenterColumn)
+    uint64_t winningColumns[2] = {0, 0}; // jak Game::winningColumns
+};
+
+// Ocena pozycji z perspektywy gracza me (0 = X, 1 = O) z liczb wzorców.
+int scorePatterns(const PatternCounts &counts, int me)
+{
+    int opponent = 1 - me;
+
+    if (counts.fours[me])
+        return 1000000;
+    if (counts.fours[opponent])
+        return -1000000;
+
+    int score = 0;
+
+    if (counts.winningColumns[me])
+        score += 100000;
+    if (counts.winningColumns[opponent])
+        score -= 150000;
+
+    score += counts.threes[me] * 50000;
+    score -= counts.threes[opponent] * 75000;
+
+    score += counts.twos[me] * 1000;
+    score -= counts.twos[opponent] * 1500;
+
+    score += counts.center[me] * 100;
+    score -= counts.center[opponent] * 100;
+
+    return score;
+}
+
+// Wektorowe liczenie wzorców oceny. Plansza (znaki ' ', 'X', 'O') jest
+// zamieniana porównaniami bajtów na trzy maski bitowe, w układzie wiersz
+// po wierszu z jedną pustą kolumną-wartownikiem: bit row * (cols + 1) + col.
+// Każdy wzorzec w danym kierunku to wtedy AND czterech przesuniętych masek,
+// a liczba jego wystąpień to popcount - wszystkie okna naraz. Okno, które
+// wychodzi poza planszę, trafia na wartownika albo poza maskę i odpada.
+//
+// Wersja jest wybierana w czasie działania (CPUID): AVX2 porównuje 32 bajty
+// naraz, SSE4.2 po 16 z POPCNT, a bez nich zostaje zwykła pętla. Wszystkie
+// dają te same liczby. Działa dla plansz, w których rows * (cols + 1) <= 64.
+//
+// W układzie COLUMNS bity są jak w BitboardConnectFour (kolumna po
+// kolumnie, od dołu, wartownik na szczycie kolumny), a maski graczy
+// przychodzą gotowe (countBits) - zostaje samo liczenie, z POPCNT,
+// gdy procesor go ma. Układ zmienia tylko przesunięcia kierunków.
+class PatternKernel
+{
+public:
+    enum Level
+    {
+        SCALAR,
+        SSE42,
+        AVX2
+    };
+
+    enum Layout
+    {
+        ROWS,   // bit row * (cols + 1) + col, wiersz 0 na górze
+        COLUMNS // bit col * (rows + 1) + wysokość od dołu
+    };
+
+private:
+    struct BoardMasks
+    {
+        uint64_t x;
+        uint64_t o;
+        uint64_t empty;
+    };
+
+    // Wzorce jednego kierunku; wzorzec to maska pozycji okna zajętych przez
+    // gracza (bit i ustawiony = pionek, wyzerowany = puste pole).
+    struct DirectionPatterns
+    {
+        int step;
+        int threeCount = 0;
+        int twoCount = 0;
+        uint8_t threes[8];
+        uint8_t twos[8];
+    };
+
+    int rows;
+    int cols;
+    Layout layout;
+    int rowStep;    // przesunięcie bitu o wiersz w dół
+    int columnStep; // przesunięcie bitu o kolumnę w prawo
+    uint64_t boardMask = 0;
+    uint64_t centerMask = 0;
+    uint64_t bottomMask = 0; // najniższy wiersz
+    vector<uint64_t> columnMasks;
+    DirectionPatterns directions[4];
+
+public:
+    PatternKernel(int rows, int cols, Layout layout = ROWS);
+
+    static bool fits(int rows, int cols, Layout layout = ROWS);
+    static Level detectLevel();
+    static Level activeLevel();
+    static void setLevel(Level level);
+    static const char *levelName(Level level);
+
+    PatternCounts count(const char *board) const;
+    PatternCounts countBits(uint64_t x, uint64_t o) const; // maski w układzie kernela
+
+private:
+    static Level &selectedLevel();
+
+    uint64_t cellBit(int row, int col) const;
+
+    static int addPatterns(uint8_t *target, const vector<string> &patterns);
+    BoardMasks spreadRows(uint64_t denseX, uint64_t denseO) const;
+    BoardMasks loadScalar(const char *board) const;
+
+    // wstawiana w wersje AVX2/SSE4.2, żeby popcount był tam instrukcją POPCNT
+    inline __attribute__((always_inline)) PatternCounts countMasks(const BoardMasks &masks) const;
+
+#ifdef PATTERN_KERNEL_X86
+    __attribute__((target("popcnt"))) PatternCounts countPopcnt(const BoardMasks &masks) const;
+    __attribute__((target("sse4.2,popcnt"))) PatternCounts countSse42(const char *board) const;
+    __attribute__((target("avx2,popcnt"))) PatternCounts countAvx2(const char *board) const;
+#endif
+
+    inline __attribute__((always_inline)) uint64_t toColumns(uint64_t cells) const;
+    static uint64_t shifted(uint64_t mask, int shift);
+};
+
+PatternKernel::PatternKernel(int rows, int cols, Layout layout)
+    : rows(rows),
+      cols(cols),
+      layout(layout),
+      rowStep(layout == ROWS ? cols + 1 : -1),
+      columnStep(layout == ROWS ? 1 : rows + 1)
+{
+    if (!fits(rows, cols, layout))
+        return;
+
+    directions[HORIZONTAL].step = columnStep;
+    directions[VERTICAL].step = rowStep;
+    directions[DIAG_DOWN].step = rowStep + columnStep;
+    directions[DIAG_UP].step = columnStep - rowStep;
+
+    for (int dir = 0; dir < 4; dir++)
+    {
+        DirectionPatterns &patterns = directions[dir];
+        patterns.threeCount = addPatterns(patterns.threes, WindowTable::threePatterns((WindowDirection)dir));
+        patterns.twoCount = addPatterns(patterns.twos, WindowTable::twoPatterns((WindowDirection)dir));
+    }
+
+    columnMasks.assign(cols, 0);
+    for (int row = 0; row < rows; row++)
+    {
+        for (int col = 0; col < cols; col++)
+        {
+            boardMask |= cellBit(row, col);
+            columnMasks[col] |= cellBit(row, col);
+        }
+        centerMask |= cellBit(row, cols / 2) | cellBit(row, (cols - 1) / 2);
+    }
+    for (int col = 0; col < cols; col++)
+        bottomMask |= cellBit(rows - 1, col);
+}
+
+bool PatternKernel::fits(int rows, int cols, Layout layout)
+{
+    return layout == ROWS ? rows * (cols + 1) <= 64 : cols * (rows + 1) <= 64;
+}
+
+uint64_t PatternKernel::cellBit(int row, int col) const
+{
+    if (layout == ROWS)
+        return 1ULL << (row * rowStep + col);
+    return 1ULL << (col * columnStep + rows - 1 - row);
+}
+
+int PatternKernel::addPatterns(uint8_t *target, const vector<string> &patterns)
+{
+    int count = 0;
+    for (const string &pattern : patterns)
+    {
+        uint8_t mine = 0;
+        for (int i = 0; i < 4; i++)
+        {
+            if (pattern[i] == 'X')
+                mine |= 1 << i;
+        }
+        target[count++] = mine;
+    }
+    return count;
+}
+
+PatternKernel::Level PatternKernel::detectLevel()
+{
+#ifdef PATTERN_KERNEL_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("popcnt"))
+        return AVX2;
+    if (__builtin_cpu_supports("sse4.2") && __builtin_cpu_supports("popcnt"))
+        return SSE42;
+#endif
+    return SCALAR;
+}
+
+PatternKernel::Level &PatternKernel::selectedLevel()
+{
+    static Level level = detectLevel();
+    return level;
+}
+
+PatternKernel::Level PatternKernel::activeLevel()
+{
+    return selectedLevel();
+}
+
+// Pozwala wymusić słabszą wersję (np. do porównań); mocniejszej niż
+// wspiera procesor nie da się wybrać.
+void PatternKernel::setLevel(Level level)
+{
+    selectedLevel() = min(level, detectLevel());
+}
+
+const char *PatternKernel::levelName(Level level)
+{
+    switch (level)
+    {
+    case AVX2:
+        return "AVX2";
+    case SSE42:
+        return "SSE4.2";
+    default:
+        return "skalarna";
+    }
+}
+
+PatternCounts PatternKernel::count(const char *board) const
+{
+#ifdef PATTERN_KERNEL_X86
+    switch (selectedLevel())
+    {
+    case AVX2:
+        return countAvx2(board);
+    case SSE42:
+        return countSse42(board);
+    default:
+        break;
+    }
+#endif
+    return countMasks(loadScalar(board));
+}
+
+// Tu nie ma bajtów do porównywania - z SSE4.2 / AVX2 zostaje sam POPCNT.
+PatternCounts PatternKernel::countBits(uint64_t x, uint64_t o) const
+{
+    BoardMasks masks{x, o, boardMask & ~(x | o)};
+#ifdef PATTERN_KERNEL_X86
+    if (selectedLevel() != SCALAR)
+        return countPopcnt(masks);
+#endif
+    return countMasks(masks);
+}
+
+// Z masek gęstych (bit row * cols + col) do układu z wartownikiem (ROWS).
+PatternKernel::BoardMasks PatternKernel::spreadRows(uint64_t denseX, uint64_t denseO) const
+{
+    uint64_t rowMask = (1ULL << cols) - 1;
+    BoardMasks masks{0, 0, 0};
+    for (int row = 0; row < rows; row++)
+    {
+        masks.x |= ((denseX >> (row * cols)) & rowMask) << (row * rowStep);
+        masks.o |= ((denseO >> (row * cols)) & rowMask) << (row * rowStep);
+    }
+    masks.empty = boardMask & ~(masks.x | masks.o);
+    return masks;
+}
+
+PatternKernel::BoardMasks PatternKernel::loadScalar(const char *board) const
+{
+    uint64_t denseX = 0, denseO = 0;
+    for (int i = 0; i < rows * cols; i++)
+    {
+        denseX |= (uint64_t)(board[i] == 'X') << i;
+        denseO |= (uint64_t)(board[i] == 'O') << i;
+    }
+    return spreadRows(denseX, denseO);
+}
+
+uint64_t PatternKernel::shifted(uint64_t mask, int shift)
+{
+    return shift >= 0 ? mask >> shift : mask << -shift;
+}
+
+// Kolumny, w których leży któreś z pól cells; zwykle cells jest puste.
+uint64_t PatternKernel::toColumns(uint64_t cells) const
+{
+    uint64_t columns = 0;
+    for (int col = 0; cells && col < cols; col++)
+    {
+        if (cells & columnMasks[col])
+        {
+            columns |= 1ULL << col;
+            cells &= ~columnMasks[col];
+        }
+    }
+    return columns;
+}
+
+// Maski przesunięte o 0..3 kroki: bit p w shiftedMine[i] mówi, czy i-te
+// pole okna zaczynającego się w p należy do gracza. Wzorzec to AND czterech
+// takich masek, a popcount wyniku to liczba pasujących okien. Okna z trzema
+// pionkami gracza przesunięte z powrotem o pozycję brakującego pola dają
+// pola wygrywające.
+PatternCounts PatternKernel::countMasks(const BoardMasks &masks) const
+{
+    PatternCounts counts;
+    const uint64_t pieces[2] = {masks.x, masks.o};
+    uint64_t winningCells[2] = {0, 0};
+
+    for (const DirectionPatterns &patterns : directions)
+    {
+        uint64_t shiftedEmpty[4];
+        for (int i = 0; i < 4; i++)
+            shiftedEmpty[i] = shifted(masks.empty, i * patterns.step);
+
+        for (int player = 0; player < 2; player++)
+        {
+            uint64_t shiftedMine[4];
+            for (int i = 0; i < 4; i++)
+                shiftedMine[i] = shifted(pieces[player], i * patterns.step);
+
+            counts.fours[player] += __builtin_popcountll(
+                shiftedMine[0] & shiftedMine[1] & shiftedMine[2] & shiftedMine[3]);
+
+            for (int hole = 0; hole < 4; hole++)
+            {
+                uint64_t starts = ~0ULL;
+                for (int i = 0; i < 4; i++)
+                {
+                    if (i != hole)
+                        starts &= shiftedMine[i];
+                }
+                winningCells[player] |= shifted(starts, -hole * patterns.step);
+            }
+
+            for (int k = 0; k < patterns.threeCount + patterns.twoCount; k++)
+            {
+                bool isThree = k < patterns.threeCount;
+                uint8_t mine = isThree ? patterns.threes[k] : patterns.twos[k - patterns.threeCount];
+                uint64_t hits = ~0ULL;
+                for (int i = 0; i < 4; i++)
+                    hits &= (mine >> i) & 1 ? shiftedMine[i] : shiftedEmpty[i];
+
+                (isThree ? counts.threes : counts.twos)[player] += __builtin_popcountll(hits);
+            }
+        }
+    }
+
+    // wolne pole, pod którym jest pionek albo koniec planszy
+    uint64_t playable = masks.empty & (shifted(~masks.empty, rowStep) | bottomMask);
+    for (int player = 0; player < 2; player++)
+    {
+        counts.center[player] = __builtin_popcountll(pieces[player] & centerMask);
+        counts.winningColumns[player] = toColumns(winningCells[player] & playable);
+    }
+    return counts;
+}
+
+#ifdef PATTERN_KERNEL_X86
+PatternCounts PatternKernel::countPopcnt(const BoardMasks &masks) const
+{
+    return countMasks(masks);
+}
+
+PatternCounts PatternKernel::countSse42(const char *board) const
+{
+    int cells = rows * cols;
+    const __m128i x = _mm_set1_epi8('X');
+    const __m128i o = _mm_set1_epi8('O');
+
+    uint64_t denseX = 0, denseO = 0;
+    int i = 0;
+    for (; i + 16 <= cells; i += 16)
+    {
+        __m128i bytes = _mm_loadu_si128((const __m128i *)(board + i));
+        denseX |= (uint64_t)(uint16_t)_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, x)) << i;
+        denseO |= (uint64_t)(uint16_t)_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, o)) << i;
+    }
+    for (; i < cells; i++)
+    {
+        denseX |= (uint64_t)(board[i] == 'X') << i;
+        denseO |= (uint64_t)(board[i] == 'O') << i;
+    }
+
+    return countMasks(spreadRows(denseX, denseO));
+}
+
+PatternCounts PatternKernel::countAvx2(const char *board) const
+{
+    int cells = rows * cols;
+    const __m256i x = _mm256_set1_epi8('X');
+    const __m256i o = _mm256_set1_epi8('O');
+
+    uint64_t denseX = 0, denseO = 0;
+    int i = 0;
+    for (; i + 32 <= cells; i += 32)
+    {
+        __m256i bytes = _mm256_loadu_si256((const __m256i *)(board + i));
+        denseX |= (uint64_t)(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(bytes, x)) << i;
+        denseO |= (uint64_t)(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(bytes, o)) << i;
+    }
+    for (; i < cells; i++)
+    {
+        denseX |= (uint64_t)(board[i] == 'X') << i;
+        denseO |= (uint64_t)(board[i] == 'O') << i;
+    }
+
+    return countMasks(spreadRows(denseX, denseO));
+}
+#endif
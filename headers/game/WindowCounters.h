@@ -0,0 +1,346 @@
+#pragma once
+#include <iostream>
+#include <vector>
+#include <cstdint>
+#include <climits>
+#include "Game.h"
+#include "Move.h"
+#include "WindowTable.h"
+#include "PatternKernel.h"
+
+using namespace std;
+
+// Tabele okien dla WindowCounters, gdy rozmiar planszy jest znany dopiero
+// w czasie działania (ConnectFour). Tabela należy do gry, widok tylko na
+// nią wskazuje - kopiuje się go razem z grą, która trzyma tę samą tabelę.
+struct WindowTableView
+{
+    using Codes = vector<uint8_t>;
+    using Threats = vector<uint8_t>;
+
+    const WindowTable *table = nullptr;
+
+    int rows() const;
+    int cols() const;
+    int windowCount() const;
+    const Window &window(int index) const;
+    const CellWindows &cellWindows(int cell) const;
+    Codes emptyCodes() const;
+    Threats emptyThreats() const;
+};
+
+int WindowTableView::rows() const
+{
+    return table->rows;
+}
+
+int WindowTableView::cols() const
+{
+    return table->cols;
+}
+
+int WindowTableView::windowCount() const
+{
+    return table->windows.size();
+}
+
+const Window &WindowTableView::window(int index) const
+{
+    return table->windows[index];
+}
+
+const CellWindows &WindowTableView::cellWindows(int cell) const
+{
+    return table->cellWindows[cell];
+}
+
+WindowTableView::Codes WindowTableView::emptyCodes() const
+{
+    return Codes(table->windows.size(), 0);
+}
+
+WindowTableView::Threats WindowTableView::emptyThreats() const
+{
+    return Threats(2 * table->rows * table->cols, 0);
+}
+
+// Stan oceny przyrostowej wspólny dla ConnectFour i FixedConnectFour: kod
+// każdego okna, liczniki zagrożeń na polach i sumy wzorców dla X (0) i O (1),
+// aktualizowane w update tylko dla okien przez zmienione pole. Tables daje
+// okna planszy - WindowTableView albo stałe tabele FixedConnectFour, przy
+// których pętle mają stałe granice.
+template <typename Tables>
+class WindowCounters
+{
+private:
+    Tables tables;
+    typename Tables::Codes windowCodes;
+    typename Tables::Threats threats; // [gracz * pola + pole]: ile okien to pole domyka do czwórki
+    int threes[2] = {0, 0};
+    int twos[2] = {0, 0};
+    int fours[2] = {0, 0};
+    int center[2] = {0, 0};
+
+public:
+    explicit WindowCounters(Tables tables = Tables());
+
+    void clear();
+    void update(const Game &game, const Move &move, int sign);
+    int windowCode(int window) const;
+
+    uint64_t winningColumns(const Game &game, int player) const;
+    PatternCounts counts(const Game &game) const;
+    PatternCounts countAll(const Game &game, const char *board) const;
+    void evalDeltas(const Game &game, char player, int *deltas) const;
+
+private:
+    static int playerIndex(char player);
+
+    void applyWindow(int window, int sign);
+    PatternCounts countsAfterMove(const Game &game, int col, int me) const;
+};
+
+template <typename Tables>
+WindowCounters<Tables>::WindowCounters(Tables tables)
+    : tables(tables)
+{
+    clear();
+}
+
+template <typename Tables>
+void WindowCounters<Tables>::clear()
+{
+    windowCodes = tables.emptyCodes();
+    threats = tables.emptyThreats();
+    for (int p = 0; p < 2; p++)
+    {
+        threes[p] = 0;
+        twos[p] = 0;
+        fours[p] = 0;
+        center[p] = 0;
+    }
+}
+
+template <typename Tables>
+int WindowCounters<Tables>::playerIndex(char player)
+{
+    return player == 'X' ? 0 : 1;
+}
+
+// sign = 1 dla postawienia pionka, -1 dla jego zdjęcia
+template <typename Tables>
+void WindowCounters<Tables>::update(const Game &game, const Move &move, int sign)
+{
+    const CellWindows &cellWindows = tables.cellWindows(move.row * tables.cols() + move.column);
+    for (int i = 0; i < cellWindows.count; i++)
+    {
+        const WindowSlot &slot = cellWindows.slots[i];
+        applyWindow(slot.window, -1);
+        windowCodes[slot.window] += sign * WindowTable::cellCode(slot.position, move.player);
+        applyWindow(slot.window, 1);
+    }
+
+    if (game.isCenterColumn(move.column))
+        center[playerIndex(move.player)] += sign;
+}
+
+template <typename Tables>
+void WindowCounters<Tables>::applyWindow(int window, int sign)
+{
+    const Window &w = tables.window(window);
+    const WindowPattern &p = WindowTable::pattern(w.direction, windowCodes[window]);
+    int cells = tables.rows() * tables.cols();
+
+    for (int player = 0; player < 2; player++)
+    {
+        threes[player] += sign * p.threes[player];
+        twos[player] += sign * p.twos[player];
+        fours[player] += sign * p.fours[player];
+        if (p.threat[player] >= 0)
+        {
+            int pos = p.threat[player];
+            threats[player * cells + w.cell[pos]] += sign;
+        }
+    }
+}
+
+template <typename Tables>
+int WindowCounters<Tables>::windowCode(int window) const
+{
+    return windowCodes[window];
+}
+
+// Pole na szczycie kolumny domyka jakieś okno gracza player (0 = X, 1 = O).
+template <typename Tables>
+uint64_t WindowCounters<Tables>::winningColumns(const Game &game, int player) const
+{
+    const uint8_t *playerThreats = threats.data() + player * tables.rows() * tables.cols();
+    uint64_t columns = 0;
+    for (int col = 0; col < tables.cols(); col++)
+    {
+        int row = tables.rows() - 1 - game.getColumnHeight(col);
+        if (row >= 0 && playerThreats[row * tables.cols() + col])
+            columns |= 1ULL << col;
+    }
+    return columns;
+}
+
+// Liczby wzorców z sum utrzymywanych przyrostowo.
+template <typename Tables>
+PatternCounts WindowCounters<Tables>::counts(const Game &game) const
+{
+    PatternCounts counts;
+    for (int p = 0; p < 2; p++)
+    {
+        counts.fours[p] = fours[p];
+        counts.threes[p] = threes[p];
+        counts.twos[p] = twos[p];
+        counts.center[p] = center[p];
+        counts.winningColumns[p] = winningColumns(game, p);
+    }
+    return counts;
+}
+
+// Pełne przeliczenie jednym przejściem po wszystkich oknach planszy board,
+// niezależne od stanu przyrostowego (wzorce z tablicy według kodu okna).
+template <typename Tables>
+PatternCounts WindowCounters<Tables>::countAll(const Game &game, const char *board) const
+{
+    int rows = tables.rows();
+    int cols = tables.cols();
+    int cells = rows * cols;
+
+    PatternCounts counts;
+    typename Tables::Threats threatCells = tables.emptyThreats();
+    const WindowPattern *patterns = WindowTable::patterns();
+    for (int w = 0; w < tables.windowCount(); w++)
+    {
+        const Window &window = tables.window(w);
+        const WindowPattern &p = patterns[window.direction * 81 + WindowTable::windowCode(board, window)];
+        for (int q = 0; q < 2; q++)
+        {
+            counts.threes[q] += p.threes[q];
+            counts.twos[q] += p.twos[q];
+            counts.fours[q] += p.fours[q];
+            if (p.threat[q] >= 0)
+                threatCells[q * cells + window.cell[p.threat[q]]] = 1;
+        }
+    }
+
+    for (int col = 0; col < cols; col++)
+    {
+        int height = game.getColumnHeight(col);
+        if (game.isCenterColumn(col))
+        {
+            for (int h = 0; h < height; h++)
+                counts.center[playerIndex(board[(rows - 1 - h) * cols + col])]++;
+        }
+
+        int row = rows - 1 - height;
+        if (row < 0)
+            continue;
+        for (int q = 0; q < 2; q++)
+        {
+            if (threatCells[q * cells + row * cols + col])
+                counts.winningColumns[q] |= 1ULL << col;
+        }
+    }
+    return counts;
+}
+
+// Liczniki po ruchu gracza me w kolumnę col bez zmiany planszy: sumy
+// wzorców i zagrożeń poprawione tylko o okna przez pole, na które spadnie
+// pionek - tak samo, jak zrobiłby to update.
+template <typename Tables>
+PatternCounts WindowCounters<Tables>::countsAfterMove(const Game &game, int col, int me) const
+{
+    int rows = tables.rows();
+    int cols = tables.cols();
+    int cells = rows * cols;
+    int cell = (rows - 1 - game.getColumnHeight(col)) * cols + col;
+    char player = me == 0 ? 'X' : 'O';
+
+    PatternCounts counts;
+    for (int p = 0; p < 2; p++)
+    {
+        counts.fours[p] = fours[p];
+        counts.threes[p] = threes[p];
+        counts.twos[p] = twos[p];
+        counts.center[p] = center[p];
+    }
+    if (game.isCenterColumn(col))
+        counts.center[me]++;
+
+    // zmienione liczniki zagrożeń: indeks jak w threats i zmiana o +1/-1
+    int changedThreat[64];
+    int threatDelta[64];
+    int changes = 0;
+
+    const WindowPattern *patterns = WindowTable::patterns();
+    const CellWindows &cellWindows = tables.cellWindows(cell);
+    for (int i = 0; i < cellWindows.count; i++)
+    {
+        const WindowSlot &slot = cellWindows.slots[i];
+        const Window &window = tables.window(slot.window);
+        int code = windowCodes[slot.window];
+        const WindowPattern &before = patterns[window.direction * 81 + code];
+        const WindowPattern &after = patterns[window.direction * 81 + code + WindowTable::cellCode(slot.position, player)];
+
+        for (int q = 0; q < 2; q++)
+        {
+            counts.fours[q] += after.fours[q] - before.fours[q];
+            counts.threes[q] += after.threes[q] - before.threes[q];
+            counts.twos[q] += after.twos[q] - before.twos[q];
+            if (before.threat[q] >= 0)
+            {
+                changedThreat[changes] = q * cells + window.cell[before.threat[q]];
+                threatDelta[changes++] = -1;
+            }
+            if (after.threat[q] >= 0)
+            {
+                changedThreat[changes] = q * cells + window.cell[after.threat[q]];
+                threatDelta[changes++] = 1;
+            }
+        }
+    }
+
+    for (int c = 0; c < cols; c++)
+    {
+        int row = rows - 1 - game.getColumnHeight(c) - (c == col ? 1 : 0);
+        if (row < 0)
+            continue;
+        for (int q = 0; q < 2; q++)
+        {
+            int index = q * cells + row * cols + c;
+            int count = threats[index];
+            for (int i = 0; i < changes; i++)
+            {
+                if (changedThreat[i] == index)
+                    count += threatDelta[i];
+            }
+            if (count)
+                counts.winningColumns[q] |= 1ULL << c;
+        }
+    }
+    return counts;
+}
+
+// Game::evalDeltas bez wykonywania ruchów: dla każdej kolumny różnica
+// ocen (gracz - rywal) po ruchu gracza player, INT_MIN dla pełnej.
+template <typename Tables>
+void WindowCounters<Tables>::evalDeltas(const Game &game, char player, int *deltas) const
+{
+    int me = playerIndex(player);
+    int before = game.getEval(player) - game.getEval(player == 'X' ? 'O' : 'X');
+
+    for (int col = 0; col < tables.cols(); col++)
+    {
+        if (game.getColumnHeight(col) == tables.rows())
+        {
+            deltas[col] = INT_MIN;
+            continue;
+        }
+        PatternCounts counts = countsAfterMove(game, col, me);
+        deltas[col] = scorePatterns(counts, me) - scorePatterns(counts, 1 - me) - before;
+    }
+}
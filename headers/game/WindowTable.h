@@ -0,0 +1,215 @@
+#pragma once
+#include <iostream>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <cstdint>
+
+using namespace std;
+
+enum WindowDirection
+{
+    HORIZONTAL,
+    VERTICAL,
+    DIAG_DOWN, // (r, c) -> (r + 1, c + 1)
+    DIAG_UP    // (r, c) -> (r - 1, c + 1)
+};
+
+// Czwórka kolejnych pól planszy, w kolejności w jakiej skanuje je ConnectFour.
+struct Window
+{
+    int row[4];
+    int col[4];
+    int cell[4]; // row * cols + col
+    WindowDirection direction;
+};
+
+// Przynależność pola do okna: numer okna i pozycja pola w tym oknie.
+struct WindowSlot
+{
+    int window;
+    int position;
+};
+
+// Okna przechodzące przez jedno pole (najwyżej po 4 w każdym kierunku).
+struct CellWindows
+{
+    int count = 0;
+    WindowSlot slots[16];
+};
+
+// Wkład jednego okna do oceny, osobno dla X (indeks 0) i O (indeks 1).
+// threat to pozycja jedynego pustego pola okna, w którym pozostałe trzy
+// należą do gracza (-1 gdy brak).
+struct WindowPattern
+{
+    int8_t threes[2];
+    int8_t twos[2];
+    int8_t fours[2];
+    int8_t threat[2];
+};
+
+// Stałe dla danego rozmiaru planszy: wszystkie okna i listy okien przechodzących
+// przez każde pole. Współdzielone przez klony gry.
+struct WindowTable
+{
+    int rows;
+    int cols;
+    vector<Window> windows;
+    vector<CellWindows> cellWindows; // indeks pola: row * cols + col
+
+    WindowTable(int rows, int cols);
+
+    // Stan okna jest liczbą w systemie trójkowym: pole i waży 3^i,
+    // puste = 0, X = 1, O = 2.
+    static int cellCode(int position, char player);
+    static int windowCode(const char *board, const Window &window);
+    static const WindowPattern &pattern(WindowDirection direction, int code);
+
+    // Cała tablica wzorców, [kierunek * 81 + kod]; w pętlach po oknach
+    // lepiej pobrać ją raz niż wołać pattern() dla każdego okna.
+    static const WindowPattern *patterns();
+
+    // Wzorce oceny w danym kierunku ('X' = pionek gracza, '_' = puste pole).
+    static const vector<string> &threePatterns(WindowDirection direction);
+    static const vector<string> &twoPatterns(WindowDirection direction);
+
+private:
+    void addWindow(int row, int col, int dRow, int dCol, WindowDirection direction);
+};
+
+WindowTable::WindowTable(int rows, int cols)
+    : rows(rows),
+      cols(cols),
+      cellWindows(rows * cols)
+{
+    for (int r = 0; r < rows; ++r)
+        for (int c = 0; c < cols - 3; ++c)
+            addWindow(r, c, 0, 1, HORIZONTAL);
+
+    for (int r = 0; r < rows - 3; ++r)
+        for (int c = 0; c < cols; ++c)
+            addWindow(r, c, 1, 0, VERTICAL);
+
+    for (int r = 0; r < rows - 3; ++r)
+        for (int c = 0; c < cols - 3; ++c)
+            addWindow(r, c, 1, 1, DIAG_DOWN);
+
+    for (int r = 3; r < rows; ++r)
+        for (int c = 0; c < cols - 3; ++c)
+            addWindow(r, c, -1, 1, DIAG_UP);
+}
+
+void WindowTable::addWindow(int row, int col, int dRow, int dCol, WindowDirection direction)
+{
+    Window window;
+    window.direction = direction;
+    for (int i = 0; i < 4; i++)
+    {
+        window.row[i] = row + i * dRow;
+        window.col[i] = col + i * dCol;
+        window.cell[i] = window.row[i] * cols + window.col[i];
+        CellWindows &cell = cellWindows[window.cell[i]];
+        cell.slots[cell.count++] = WindowSlot{(int)windows.size(), i};
+    }
+    windows.push_back(window);
+}
+
+int WindowTable::cellCode(int position, char player)
+{
+    static const int pow3[4] = {1, 3, 9, 27};
+    return pow3[position] * (player == 'X' ? 1 : 2);
+}
+
+// Kod okna policzony od zera z planszy (board[row * cols + col]).
+int WindowTable::windowCode(const char *board, const Window &window)
+{
+    int code = 0;
+    for (int i = 3; i >= 0; i--)
+    {
+        char c = board[window.cell[i]];
+        code = code * 3 + (c == 'X' ? 1 : c == 'O' ? 2 : 0);
+    }
+    return code;
+}
+
+const WindowPattern &WindowTable::pattern(WindowDirection direction, int code)
+{
+    return patterns()[direction * 81 + code];
+}
+
+// Wzorce oceny (pola od początku okna). Zbiory różnią się między
+// kierunkami: w pionie liczone są tylko XXX_ i XX__, a ukośnie nie ma X_X_,
+// _X_X i X__X - tak liczyła je ocena od początku i wyniki muszą się zgadzać,
+// więc nie da się ich zastąpić samą liczbą pionków w oknie. Poziome zbiory
+// są zamknięte na odwrócenie okna, więc ocena pozycji i jej lustrzanego
+// odbicia jest ta sama (wymagają tego klucze kanoniczne).
+const vector<string> &WindowTable::threePatterns(WindowDirection direction)
+{
+    static const vector<string> threes[4] = {
+        {"XXX_", "XX_X", "X_XX", "_XXX"},
+        {"XXX_"},
+        {"XXX_", "XX_X", "X_XX", "_XXX"},
+        {"XXX_", "XX_X", "X_XX", "_XXX"}};
+    return threes[direction];
+}
+
+const vector<string> &WindowTable::twoPatterns(WindowDirection direction)
+{
+    static const vector<string> twos[4] = {
+        {"XX__", "_XX_", "__XX", "X_X_", "_X_X", "X__X"},
+        {"XX__"},
+        {"XX__", "_XX_", "__XX"},
+        {"XX__", "_XX_", "__XX"}};
+    return twos[direction];
+}
+
+const WindowPattern *WindowTable::patterns()
+{
+    static const vector<WindowPattern> table = []()
+    {
+        vector<WindowPattern> table(4 * 81);
+        for (int dir = 0; dir < 4; dir++)
+        {
+            const vector<string> &threes = threePatterns((WindowDirection)dir);
+            const vector<string> &twos = twoPatterns((WindowDirection)dir);
+            for (int code = 0; code < 81; code++)
+            {
+                char cells[4];
+                for (int i = 0, rest = code; i < 4; i++, rest /= 3)
+                    cells[i] = " XO"[rest % 3];
+
+                WindowPattern &p = table[dir * 81 + code];
+                for (int player = 0; player < 2; player++)
+                {
+                    char me = player == 0 ? 'X' : 'O';
+                    // zamiana na alfabet wzorców: 'X' = mój pionek, '_' = puste
+                    string window(4, '?');
+                    int mine = 0, empty = 0, emptyAt = -1;
+                    for (int i = 0; i < 4; i++)
+                    {
+                        if (cells[i] == me)
+                        {
+                            window[i] = 'X';
+                            mine++;
+                        }
+                        else if (cells[i] == ' ')
+                        {
+                            window[i] = '_';
+                            empty++;
+                            emptyAt = i;
+                        }
+                    }
+
+                    p.threes[player] = count(threes.begin(), threes.end(), window);
+                    p.twos[player] = count(twos.begin(), twos.end(), window);
+                    p.fours[player] = mine == 4;
+                    p.threat[player] = (mine == 3 && empty == 1) ? emptyAt : -1;
+                }
+            }
+        }
+        return table;
+    }();
+
+    return table.data();
+}
@@ -0,0 +1,202 @@
+#pragma once
+#include <iostream>
+#include <random>
+#include <vector>
+#include "../game/ConnectFour.h"
+#include "../game/BitboardConnectFour.h"
+#include "../game/FixedConnectFour.h"
+
+using namespace std;
+
+// Tryb porównawczy: rozgrywa losowe partie jednocześnie na ConnectFour,
+// BitboardConnectFour i (dla 6x7 i 7x8) FixedConnectFour i sprawdza, czy po
+// każdym ruchu (i cofnięciu) backendy zwracają te same ruchy, wygrane,
+// kolumny wygrywające i oceny pozycji, a ocena utrzymywana w addMove/undoMove
+// i zmiany ocen z evalDeltas zgadzają się z pełnym przeliczeniem. Równolegle
+// idzie partia lustrzana (te same ruchy odbite lewo-prawo), która musi mieć
+// hash równy getMirrorHash i tę samą ocenę - na tym opiera się dzielenie
+// wpisów między pozycją a jej odbiciem.
+class BackendTester
+{
+private:
+    int rows;
+    int cols;
+    mt19937 gen;
+
+public:
+    BackendTester(int rows, int cols, unsigned seed = random_device{}());
+
+    bool runRandomGames(int numGames);
+
+private:
+    bool compare(const ConnectFour &reference, const Game &other, const char *otherName, int gameNumber);
+    static bool sameEvalDeltas(const ConnectFour &reference, const Game &other);
+    static bool matchesMirror(const ConnectFour &reference, const ConnectFour &mirrored);
+};
+
+BackendTester::BackendTester(int rows, int cols, unsigned seed)
+    : rows(rows),
+      cols(cols),
+      gen(seed)
+{
+}
+
+bool BackendTester::runRandomGames(int numGames)
+{
+    printf("\n=== PORÓWNANIE BACKENDÓW %dx%d, %d GIER ===\n", rows, cols, numGames);
+
+    ConnectFour reference(rows, cols);
+    ConnectFour mirrored(rows, cols);
+    vector<unique_ptr<Game>> backends;
+    vector<const char *> names;
+
+    backends.push_back(make_unique<BitboardConnectFour>(rows, cols));
+    names.push_back("Bitboard");
+    if (!dynamic_cast<ConnectFour *>(makeConnectFour(rows, cols).get()))
+    {
+        backends.push_back(makeConnectFour(rows, cols));
+        names.push_back("Fixed");
+    }
+
+    if (reference.getRows() != backends[0]->getRows() || reference.getCols() != backends[0]->getCols())
+    {
+        printf("Plansza %dx%d nie mieści się w masce bitowej.\n", rows, cols);
+        return false;
+    }
+
+    uniform_int_distribution<> undoChance(0, 9);
+    int positionsChecked = 0;
+
+    for (int i = 1; i <= numGames; i++)
+    {
+        while (true)
+        {
+            for (size_t b = 0; b < backends.size(); b++)
+            {
+                if (!compare(reference, *backends[b], names[b], i))
+                    return false;
+            }
+            if (!matchesMirror(reference, mirrored))
+            {
+                printf("\nNiezgodność z odbiciem (gra %d, ruch %d)\n", i, reference.getMoveCount());
+                reference.printBoard();
+                reference.printMoveHistory();
+                return false;
+            }
+            positionsChecked++;
+
+            vector<int> moves = reference.getValidMoves();
+            if (reference.getWinner() || moves.empty())
+                break;
+
+            // od czasu do czasu cofamy ruch, żeby sprawdzić też undoMove
+            if (reference.getMoveCount() > 0 && undoChance(gen) == 0)
+            {
+                reference.undoMove();
+                mirrored.undoMove();
+                for (auto &backend : backends)
+                    backend->undoMove();
+                continue;
+            }
+
+            uniform_int_distribution<> dist(0, moves.size() - 1);
+            int move = moves[dist(gen)];
+            reference.makeMove(move);
+            reference.checkIsGameOver();
+            mirrored.makeMove(mirrored.mirrorMove(move));
+            for (auto &backend : backends)
+            {
+                backend->makeMove(move);
+                backend->checkIsGameOver();
+            }
+        }
+
+        reference.reset();
+        mirrored.reset();
+        for (auto &backend : backends)
+            backend->reset();
+    }
+
+    printf("Zgodne: %d pozycji w %d grach\n", positionsChecked, numGames);
+    return true;
+}
+
+bool BackendTester::compare(const ConnectFour &reference, const Game &other, const char *otherName, int gameNumber)
+{
+    const char *mismatch = nullptr;
+    MoveList generated;
+    other.generateMoves(generated);
+
+    if (reference.getValidMoves() != other.getValidMoves())
+        mismatch = "getValidMoves";
+    else if (reference.getValidMoves() != vector<int>(generated.begin(), generated.end()))
+        mismatch = "generateMoves";
+    else if (reference.checkWin('X') != other.checkWin('X') ||
+             reference.checkWin('O') != other.checkWin('O'))
+        mismatch = "checkWin";
+    else if (reference.isLastMoveWin() != other.isLastMoveWin())
+        mismatch = "isLastMoveWin";
+    else if (reference.winningColumns('X') != other.winningColumns('X') ||
+             reference.winningColumns('O') != other.winningColumns('O') ||
+             reference.winningColumns('X') != reference.Game::winningColumns('X') ||
+             reference.winningColumns('O') != reference.Game::winningColumns('O'))
+        mismatch = "winningColumns";
+    else if (reference.evaluate('X') != other.evaluate('X') ||
+             reference.evaluate('O') != other.evaluate('O'))
+        mismatch = "evaluate";
+    else if (reference.getEval('X') != reference.evaluate('X') ||
+             reference.getEval('O') != reference.evaluate('O') ||
+             other.getEval('X') != other.evaluate('X') ||
+             other.getEval('O') != other.evaluate('O'))
+        mismatch = "getEval";
+    else if (!sameEvalDeltas(reference, other))
+        mismatch = "evalDeltas";
+    else if (reference.getHash() != other.getHash())
+        mismatch = "getHash";
+    else if (reference.getWinner() != other.getWinner())
+        mismatch = "getWinner";
+
+    if (!mismatch)
+        return true;
+
+    printf("\nNiezgodność w %s (%s, gra %d, ruch %d)\n", mismatch, otherName, gameNumber, reference.getMoveCount());
+    printf("ConnectFour: X=%+d, O=%+d (getEval: X=%+d, O=%+d)\n",
+           reference.evaluate('X'), reference.evaluate('O'),
+           reference.getEval('X'), reference.getEval('O'));
+    printf("%-12s X=%+d, O=%+d (getEval: X=%+d, O=%+d)\n", (string(otherName) + ":").c_str(),
+           other.evaluate('X'), other.evaluate('O'),
+           other.getEval('X'), other.getEval('O'));
+    reference.printBoard();
+    reference.printMoveHistory();
+    return false;
+}
+
+// evalDeltas obu gier i wersja domyślna z Game (ruchy na kopii) dla obu graczy.
+bool BackendTester::sameEvalDeltas(const ConnectFour &reference, const Game &other)
+{
+    for (char player : {'X', 'O'})
+    {
+        int expected[Game::MAX_SIZE], fromReference[Game::MAX_SIZE], fromOther[Game::MAX_SIZE];
+        reference.Game::evalDeltas(player, expected);
+        reference.evalDeltas(player, fromReference);
+        other.evalDeltas(player, fromOther);
+        for (int col = 0; col < reference.getCols(); col++)
+        {
+            if (fromReference[col] != expected[col] || fromOther[col] != expected[col])
+                return false;
+        }
+    }
+    return true;
+}
+
+// Hashe i orientacja kanoniczna pary pozycja-odbicie oraz symetria oceny.
+bool BackendTester::matchesMirror(const ConnectFour &reference, const ConnectFour &mirrored)
+{
+    return reference.getMirrorHash() == mirrored.getHash() &&
+           reference.getHash() == mirrored.getMirrorHash() &&
+           reference.getCanonicalHash() == mirrored.getCanonicalHash() &&
+           reference.isSymmetric() == mirrored.isSymmetric() &&
+           (reference.isSymmetric() || reference.isMirrored() != mirrored.isMirrored()) &&
+           reference.evaluate('X') == mirrored.evaluate('X') &&
+           reference.evaluate('O') == mirrored.evaluate('O');
+}
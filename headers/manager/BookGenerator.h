@@ -0,0 +1,176 @@
+#pragma once
+#include <iostream>
+#include <vector>
+#include <unordered_set>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include "../game/FixedConnectFour.h"
+#include "../ai_players/SolverPlayer.h"
+#include "../search/OpeningBook.h"
+
+using namespace std;
+
+// Tryb offline: buduje księgę otwarć. Najpierw zbiera wszystkie pozycje do
+// maxPly ruchów włącznie (każdą raz, pozycję i jej odbicie razem), potem
+// wątki biorą je po kolei i dla każdej wybierają ruch najmocniejszym
+// dostępnym graczem - SolverPlayer, czyli dokładny wynik, gdy solver
+// zmieści się w budżecie, a w przeciwnym razie AlphaBeta - i zapisuje
+// posortowane rekordy do pliku czytanego przez OpeningBook.
+//
+// Czas: na pozycję najwyżej solveBudget + fallbackBudget (domyślnie 0,5 s),
+// na losowych pozycjach 6x7 po 8 ruchach średnio około 0,3 s. Pozycji na
+// 6x7 jest 151 do ply 3, 11094 do ply 6 i 129498 do ply 8, czyli około
+// minuty, 1 h i 11-18 h pracy jednego rdzenia, dzielone przez liczbę wątków
+// (budżety są w czasie zegarowym - więcej wątków niż rdzeni nie pomaga).
+class BookGenerator
+{
+private:
+    int rows;
+    int cols;
+    int maxPly;
+    int threadCount;
+    chrono::milliseconds solveBudget;
+    chrono::milliseconds fallbackBudget;
+
+    vector<vector<uint8_t>> positions; // ruchy prowadzące do pozycji
+    vector<BookEntry> entries;
+    unordered_set<uint64_t> visited;
+    atomic<size_t> nextPosition{0};
+    atomic<size_t> donePositions{0};
+    chrono::high_resolution_clock::time_point start;
+
+public:
+    BookGenerator(int rows, int cols, int maxPly, int threads = 0,
+                  chrono::milliseconds solveBudget = chrono::milliseconds(250),
+                  chrono::milliseconds fallbackBudget = chrono::milliseconds(250));
+
+    bool generate(const string &path);
+
+private:
+    void collect(Game &game, vector<uint8_t> &moves);
+    void work();
+    BookEntry analyze(SolverPlayer &player, const Game &game);
+};
+
+// threads = 0: wszystkie rdzenie.
+BookGenerator::BookGenerator(int rows, int cols, int maxPly, int threads,
+                             chrono::milliseconds solveBudget, chrono::milliseconds fallbackBudget)
+    : rows(rows),
+      cols(cols),
+      maxPly(maxPly),
+      threadCount(threads > 0 ? threads : max(1, (int)thread::hardware_concurrency())),
+      solveBudget(solveBudget),
+      fallbackBudget(fallbackBudget)
+{
+}
+
+bool BookGenerator::generate(const string &path)
+{
+    printf("\n=== KSIĘGA OTWARĆ %dx%d, DO %d RUCHÓW ===\n", rows, cols, maxPly);
+
+    positions.clear();
+    visited.clear();
+    start = chrono::high_resolution_clock::now();
+
+    unique_ptr<Game> game = makeConnectFour(rows, cols);
+    vector<uint8_t> moves;
+    collect(*game, moves);
+    visited.clear();
+
+    printf("Pozycje: %zu, wątki: %d, najwyżej %.1f s na pozycję\n", positions.size(), threadCount,
+           (solveBudget + fallbackBudget).count() / 1000.0);
+
+    entries.assign(positions.size(), BookEntry{});
+    nextPosition = 0;
+    donePositions = 0;
+
+    vector<thread> helpers;
+    for (int i = 1; i < threadCount; i++)
+        helpers.emplace_back([this]()
+                             { work(); });
+    work();
+    for (thread &helper : helpers)
+        helper.join();
+
+    int exact = count_if(entries.begin(), entries.end(),
+                         [](const BookEntry &e)
+                         { return e.exact; });
+    printf("Pozycje: %zu (dokładnie rozwiązane: %d), czas: %.1f s\n", entries.size(), exact,
+           chrono::duration<double>(chrono::high_resolution_clock::now() - start).count());
+
+    if (!OpeningBook::write(path, rows, cols, entries))
+        return false;
+
+    printf("Zapisano %s\n", path.c_str());
+    return true;
+}
+
+// Pozycje w kolejności przejścia w głąb - kolejne są zwykle blisko siebie,
+// więc tablice solvera i AlphaBety przydają się przy następnych.
+void BookGenerator::collect(Game &game, vector<uint8_t> &moves)
+{
+    if (!visited.insert(game.getCanonicalHash()).second)
+        return;
+
+    positions.push_back(moves);
+
+    if (game.getMoveCount() >= maxPly)
+        return;
+
+    MoveList validMoves;
+    game.generateMoves(validMoves);
+    for (int move : validMoves)
+    {
+        game.makeMove(move);
+        if (!game.isLastMoveWin())
+        {
+            moves.push_back(move);
+            collect(game, moves);
+            moves.pop_back();
+        }
+        game.undoMove();
+    }
+}
+
+// Pętla jednego wątku: własny gracz i własna gra, wspólny jest tylko
+// licznik kolejnej pozycji, a wynik trafia do osobnego miejsca w entries.
+void BookGenerator::work()
+{
+    SolverPlayer player(solveBudget, fallbackBudget, 32);
+    unique_ptr<Game> game = makeConnectFour(rows, cols);
+
+    for (size_t i = nextPosition++; i < positions.size(); i = nextPosition++)
+    {
+        game->reset();
+        for (uint8_t move : positions[i])
+            game->makeMove(move);
+
+        entries[i] = analyze(player, *game);
+
+        size_t done = ++donePositions;
+        if (done % 1000 == 0)
+            printf("%zu / %zu pozycji, %.1f s\n", done, positions.size(),
+                   chrono::duration<double>(chrono::high_resolution_clock::now() - start).count());
+    }
+}
+
+BookEntry BookGenerator::analyze(SolverPlayer &player, const Game &game)
+{
+    player.clearMoveStats();
+    int move = player.chooseMove(game);
+    MoveStats stats = player.getLastMoveStats();
+
+    BookEntry entry{};
+    entry.key = game.getCanonicalHash();
+    entry.bestMove = game.canonicalMove(move);
+    entry.exact = stats.solved;
+    if (stats.solved)
+        entry.score = stats.evalScore;
+    else
+    {
+        entry.eval = stats.evalScore;
+        entry.depth = min(stats.depthReached, 255);
+    }
+    return entry;
+}
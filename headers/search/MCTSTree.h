@@ -0,0 +1,171 @@
+#pragma once
+#include <iostream>
+#include <memory>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+#include <algorithm>
+
+using namespace std;
+
+// Węzeł drzewa MCTS. Wynik jest z perspektywy gracza, który zagrał ruch
+// prowadzący do węzła - tego, który wybiera go w rodzicu: 2 punkty za
+// wygraną, 1 za remis. Wizyta jest liczona już przy zejściu w dół (wirtualna
+// przegrana), a punkty dochodzą dopiero po rozgrywce, więc inne wątki
+// widzą węzeł w trakcie rozgrywki jako gorszy i wybierają inne gałęzie.
+struct MCTSNode
+{
+    enum State : uint8_t
+    {
+        LEAF,
+        EXPANDING,
+        EXPANDED
+    };
+
+    atomic<int> visits;
+    atomic<int> score;
+    int firstChild; // dzieci leżą w puli jedno za drugim
+    uint8_t childCount;
+    uint8_t move;     // kolumna od 1
+    uint8_t terminal; // 0 = partia trwa, inaczej stały wynik: 2 wygrana, 1 remis
+    atomic<uint8_t> state;
+
+    void init(int column, int terminalScore);
+    void copyFrom(const MCTSNode &other);
+};
+
+// Pula węzłów przydzielana raz, w konstruktorze. Dzieci węzła dostają
+// kolejny blok puli jednym atomowym fetch_add, bez new i bez blokad;
+// clear() tylko cofa licznik, a węzły są inicjowane przy przydziale.
+class MCTSTree
+{
+private:
+    unique_ptr<MCTSNode[]> nodes;
+    int capacity;
+    atomic<int> used{0};
+
+public:
+    MCTSTree(int sizeMB);
+
+    void clear();
+    int allocate(int count); // indeks pierwszego węzła albo -1, gdy brak miejsca
+    int keepSubtree(int rootIndex);
+    MCTSNode &operator[](int index);
+    const MCTSNode &operator[](int index) const;
+    int size() const;
+    int getCapacity() const;
+};
+
+void MCTSNode::init(int column, int terminalScore)
+{
+    visits.store(0, memory_order_relaxed);
+    score.store(0, memory_order_relaxed);
+    firstChild = -1;
+    childCount = 0;
+    move = column;
+    terminal = terminalScore;
+    state.store(LEAF, memory_order_relaxed);
+}
+
+// Kopia poza wyszukiwaniem - wątki już nie piszą do węzłów.
+void MCTSNode::copyFrom(const MCTSNode &other)
+{
+    visits.store(other.visits.load(memory_order_relaxed), memory_order_relaxed);
+    score.store(other.score.load(memory_order_relaxed), memory_order_relaxed);
+    firstChild = other.firstChild;
+    childCount = other.childCount;
+    move = other.move;
+    terminal = other.terminal;
+    state.store(other.state.load(memory_order_relaxed), memory_order_relaxed);
+}
+
+MCTSTree::MCTSTree(int sizeMB)
+    : capacity(max(1, (int)((size_t)max(1, sizeMB) * 1024 * 1024 / sizeof(MCTSNode))))
+{
+    nodes = make_unique<MCTSNode[]>(capacity);
+}
+
+void MCTSTree::clear()
+{
+    used.store(0, memory_order_relaxed);
+}
+
+int MCTSTree::allocate(int count)
+{
+    // pełna pula: bez zapisu do wspólnego licznika
+    if (used.load(memory_order_relaxed) + count > capacity)
+        return -1;
+
+    int first = used.fetch_add(count, memory_order_relaxed);
+    if (first + count > capacity)
+    {
+        used.fetch_sub(count, memory_order_relaxed);
+        return -1;
+    }
+    return first;
+}
+
+// Zostawia tylko poddrzewo węzła rootIndex, przesunięte na początek puli
+// (korzeń pod indeksem 0), i zwraca liczbę zachowanych węzłów. Bloki dzieci
+// są przenoszone w kolejności dawnych indeksów, a każdy blok leży w puli za
+// swoim rodzicem, więc miejsce docelowe nigdy nie wyprzedza źródła i żaden
+// węzeł nie jest nadpisany przed przeniesieniem.
+int MCTSTree::keepSubtree(int rootIndex)
+{
+    vector<pair<int, int>> blocks; // (dawny początek, liczba dzieci)
+    vector<int> pending = {rootIndex};
+    while (!pending.empty())
+    {
+        const MCTSNode &node = nodes[pending.back()];
+        pending.pop_back();
+        if (node.state.load(memory_order_relaxed) != MCTSNode::EXPANDED)
+            continue;
+
+        blocks.push_back({node.firstChild, node.childCount});
+        for (int i = node.firstChild; i < node.firstChild + node.childCount; i++)
+            pending.push_back(i);
+    }
+    sort(blocks.begin(), blocks.end());
+
+    nodes[0].copyFrom(nodes[rootIndex]);
+    int next = 1;
+    vector<int> newStarts(blocks.size());
+    for (size_t b = 0; b < blocks.size(); b++)
+    {
+        newStarts[b] = next;
+        for (int i = 0; i < blocks[b].second; i++)
+            nodes[next + i].copyFrom(nodes[blocks[b].first + i]);
+        next += blocks[b].second;
+    }
+
+    for (int i = 0; i < next; i++)
+    {
+        if (nodes[i].state.load(memory_order_relaxed) != MCTSNode::EXPANDED)
+            continue;
+        auto block = lower_bound(blocks.begin(), blocks.end(), make_pair(nodes[i].firstChild, 0));
+        nodes[i].firstChild = newStarts[block - blocks.begin()];
+    }
+
+    used.store(next, memory_order_relaxed);
+    return next;
+}
+
+MCTSNode &MCTSTree::operator[](int index)
+{
+    return nodes[index];
+}
+
+const MCTSNode &MCTSTree::operator[](int index) const
+{
+    return nodes[index];
+}
+
+int MCTSTree::size() const
+{
+    return min(used.load(memory_order_relaxed), capacity);
+}
+
+int MCTSTree::getCapacity() const
+{
+    return capacity;
+}
@@ -0,0 +1,145 @@
+#pragma once
+#include <iostream>
+#include <vector>
+#include <cstdint>
+#include <cstdlib>
+#include <algorithm>
+#include "../game/MoveList.h"
+
+using namespace std;
+
+// Heurystyki kolejności ruchów; można je łączyć bitowo.
+enum OrderingFlags
+{
+    ORDER_NONE = 0,
+    ORDER_CENTER = 1,    // kolumny od środka na zewnątrz
+    ORDER_KILLERS = 2,   // ruchy, które dały odcięcie na tym samym poziomie
+    ORDER_HISTORY = 4,   // ruchy, które często dawały odcięcia
+    ORDER_HASH_MOVE = 8, // najlepszy ruch z tablicy transpozycji
+    ORDER_THREATS = 16,  // wygrana od razu, potem blokada wygranej rywala
+    ORDER_ALL = 31
+};
+
+// Porządkuje ruchy w węźle: najpierw ruch wygrywający od razu i blokujący
+// taką wygraną rywala (maski kolumn z Game::winningColumns), potem ruch
+// z tablicy transpozycji, dwa ruchy-zabójcy danego poziomu, dalej według
+// tablicy historii, a remisy rozstrzyga odległość od środka planszy.
+class MoveOrdering
+{
+private:
+    int flags;
+    int cols = 0;
+    vector<uint8_t> killers;  // [ply * 2 + slot], kolumny od 1, 0 = brak
+    vector<int64_t> history;  // [gracz * cols + kolumna]
+
+public:
+    MoveOrdering(int flags = ORDER_ALL);
+
+    void setFlags(int flags);
+    void newSearch(int cols, int maxPly);
+    void clear();
+
+    void order(MoveList &moves, int ply, int hashMove, char player,
+               uint64_t winning = 0, uint64_t blocking = 0) const;
+    void recordCutoff(int move, int ply, int depth, char player);
+
+private:
+    int64_t moveKey(int move, int ply, int hashMove, char player, uint64_t winning, uint64_t blocking) const;
+};
+
+MoveOrdering::MoveOrdering(int flags) : flags(flags) {}
+
+void MoveOrdering::setFlags(int newFlags)
+{
+    flags = newFlags;
+}
+
+// Historia zależy tylko od gracza i kolumny, więc przechodzi na kolejny ruch
+// partii - przygaszona o połowę, żeby nowe odcięcia szybko ją przeważyły.
+// Zabójcy są związani z poziomem w drzewie, a ten przesuwa się z korzeniem,
+// więc zaczynają od zera.
+void MoveOrdering::newSearch(int boardCols, int maxPly)
+{
+    if (boardCols != cols)
+    {
+        cols = boardCols;
+        history.assign(2 * cols, 0);
+    }
+    else
+    {
+        for (int64_t &value : history)
+            value /= 2;
+    }
+    killers.assign((maxPly + 1) * 2, 0);
+}
+
+// Nowa partia: historia z poprzedniej nic już nie mówi.
+void MoveOrdering::clear()
+{
+    cols = 0;
+    killers.clear();
+    history.clear();
+}
+
+int64_t MoveOrdering::moveKey(int move, int ply, int hashMove, char player, uint64_t winning, uint64_t blocking) const
+{
+    int64_t key = 0;
+
+    if (flags & ORDER_THREATS)
+    {
+        if (winning >> (move - 1) & 1)
+            key += 1LL << 62;
+        else if (blocking >> (move - 1) & 1)
+            key += 1LL << 61;
+    }
+
+    if ((flags & ORDER_HASH_MOVE) && move == hashMove)
+        key += 1LL << 60;
+
+    if ((flags & ORDER_KILLERS) && ply * 2 + 1 < (int)killers.size())
+    {
+        if (killers[ply * 2] == move)
+            key += 1LL << 59;
+        else if (killers[ply * 2 + 1] == move)
+            key += 1LL << 58;
+    }
+
+    if (flags & ORDER_HISTORY)
+        key += min<int64_t>(history[(player == 'X' ? 0 : 1) * cols + move - 1], 1LL << 48) << 8;
+
+    if (flags & ORDER_CENTER)
+        key += cols - abs(2 * (move - 1) - (cols - 1));
+
+    return key;
+}
+
+void MoveOrdering::order(MoveList &moves, int ply, int hashMove, char player,
+                         uint64_t winning, uint64_t blocking) const
+{
+    if (flags == ORDER_NONE)
+        return;
+
+    int64_t keys[MoveList::CAPACITY];
+    for (int i = 0; i < moves.size(); i++)
+        keys[i] = moveKey(moves[i], ply, hashMove, player, winning, blocking);
+
+    // sortowanie przez wstawianie - stabilne, a lista ruchów jest krótka
+    for (int i = 1; i < moves.size(); i++)
+    {
+        for (int j = i; j > 0 && keys[j] > keys[j - 1]; j--)
+        {
+            swap(keys[j], keys[j - 1]);
+            moves.swap(j, j - 1);
+        }
+    }
+}
+
+void MoveOrdering::recordCutoff(int move, int ply, int depth, char player)
+{
+    if (ply * 2 + 1 < (int)killers.size() && killers[ply * 2] != move)
+    {
+        killers[ply * 2 + 1] = killers[ply * 2];
+        killers[ply * 2] = move;
+    }
+    history[(player == 'X' ? 0 : 1) * cols + move - 1] += (int64_t)depth * depth;
+}
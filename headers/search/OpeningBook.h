@@ -0,0 +1,192 @@
+#pragma once
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "../game/Game.h"
+
+using namespace std;
+
+// Rekord księgi: pozycja (Game::getCanonicalHash) i jej najlepszy ruch
+// w orientacji kanonicznej - pozycja i jej odbicie to jeden rekord.
+// Wynik solvera (skala SolveResult) i ocena heurystyczna (skala evaluate)
+// mają osobne pola; ważne jest to, które wskazuje exact.
+struct BookEntry
+{
+    uint64_t key;
+    int32_t eval;     // ocena heurystyczna z perspektywy gracza na ruchu (exact = 0)
+    int8_t score;     // wynik solvera z perspektywy gracza na ruchu (exact = 1)
+    uint8_t bestMove; // kolumna od 1
+    uint8_t exact;    // 1 = wynik solvera, 0 = ocena heurystyczna
+    uint8_t depth;    // głębokość przeszukiwania (0 dla wyników dokładnych)
+};
+
+// Plik: nagłówek, a za nim count rekordów posortowanych rosnąco po key.
+// Liczby w kolejności bajtów maszyny, która plik zapisała.
+struct BookHeader
+{
+    char magic[8]; // "C4BOOK3"
+    uint32_t rows;
+    uint32_t cols;
+    uint64_t count;
+};
+
+static_assert(sizeof(BookEntry) == 16, "BookEntry musi mieć 16 bajtów");
+static_assert(sizeof(BookHeader) == 24, "BookHeader musi mieć 24 bajty");
+
+// Księga otwarć tylko do odczytu. Plik jest mapowany w pamięć (mmap) i nie
+// jest w ogóle parsowany - rekordy są czytane wprost z mapowania, a pozycja
+// wyszukiwana binarnie po kluczu. Otwarcie kosztuje tyle co mmap, a strony
+// pliku system wczytuje dopiero przy pierwszym odczycie.
+class OpeningBook
+{
+private:
+    void *mapping = nullptr;
+    size_t mappedSize = 0;
+    const BookHeader *header = nullptr;
+    const BookEntry *entries = nullptr;
+
+public:
+    OpeningBook() = default;
+    explicit OpeningBook(const string &path);
+    OpeningBook(const OpeningBook &) = delete;
+    OpeningBook &operator=(const OpeningBook &) = delete;
+    ~OpeningBook();
+
+    bool open(const string &path);
+    void close();
+    bool isOpen() const;
+    size_t size() const;
+
+    bool lookup(const Game &game, BookEntry &entry) const;
+
+    static bool write(const string &path, int rows, int cols, vector<BookEntry> entries);
+};
+
+OpeningBook::OpeningBook(const string &path)
+{
+    open(path);
+}
+
+OpeningBook::~OpeningBook()
+{
+    close();
+}
+
+bool OpeningBook::open(const string &path)
+{
+    close();
+
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        printf("Nie można otworzyć księgi otwarć %s\n", path.c_str());
+        return false;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || (size_t)info.st_size < sizeof(BookHeader))
+    {
+        printf("Plik %s nie jest księgą otwarć\n", path.c_str());
+        ::close(fd);
+        return false;
+    }
+
+    void *data = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (data == MAP_FAILED)
+    {
+        printf("Nie można zmapować księgi otwarć %s\n", path.c_str());
+        return false;
+    }
+
+    const BookHeader *fileHeader = (const BookHeader *)data;
+    if (memcmp(fileHeader->magic, "C4BOOK3", 8) != 0 ||
+        sizeof(BookHeader) + fileHeader->count * sizeof(BookEntry) != (size_t)info.st_size)
+    {
+        printf("Plik %s nie jest księgą otwarć albo jest uszkodzony\n", path.c_str());
+        munmap(data, info.st_size);
+        return false;
+    }
+
+    mapping = data;
+    mappedSize = info.st_size;
+    header = fileHeader;
+    entries = (const BookEntry *)((const char *)data + sizeof(BookHeader));
+    return true;
+}
+
+void OpeningBook::close()
+{
+    if (mapping)
+        munmap(mapping, mappedSize);
+    mapping = nullptr;
+    mappedSize = 0;
+    header = nullptr;
+    entries = nullptr;
+}
+
+bool OpeningBook::isOpen() const
+{
+    return mapping != nullptr;
+}
+
+size_t OpeningBook::size() const
+{
+    return header ? header->count : 0;
+}
+
+// Szuka pozycji gry; zwraca false także dla innej planszy albo ruchu, którego
+// nie da się zagrać (np. kolizja hasha).
+bool OpeningBook::lookup(const Game &game, BookEntry &entry) const
+{
+    if (!header || (int)header->rows != game.getRows() || (int)header->cols != game.getCols())
+        return false;
+
+    uint64_t key = game.getCanonicalHash();
+    const BookEntry *end = entries + header->count;
+    const BookEntry *found = lower_bound(entries, end, key,
+                                         [](const BookEntry &e, uint64_t k)
+                                         { return e.key < k; });
+    if (found == end || found->key != key)
+        return false;
+
+    int move = game.canonicalMove(found->bestMove);
+    if (move < 1 || move > game.getCols() || game.getColumnHeight(move - 1) >= game.getRows())
+        return false;
+
+    entry = *found;
+    entry.bestMove = move;
+    return true;
+}
+
+bool OpeningBook::write(const string &path, int rows, int cols, vector<BookEntry> bookEntries)
+{
+    sort(bookEntries.begin(), bookEntries.end(),
+         [](const BookEntry &a, const BookEntry &b)
+         { return a.key < b.key; });
+
+    BookHeader fileHeader{};
+    memcpy(fileHeader.magic, "C4BOOK3", 8);
+    fileHeader.rows = rows;
+    fileHeader.cols = cols;
+    fileHeader.count = bookEntries.size();
+
+    ofstream file(path, ios::binary);
+    if (!file.is_open())
+    {
+        printf("Nie można zapisać księgi otwarć %s\n", path.c_str());
+        return false;
+    }
+
+    file.write((const char *)&fileHeader, sizeof(fileHeader));
+    file.write((const char *)bookEntries.data(), bookEntries.size() * sizeof(BookEntry));
+    return file.good();
+}
@@ -0,0 +1,66 @@
+#pragma once
+#include <iostream>
+#include <cstdint>
+#include "../game/BitboardPosition.h"
+
+using namespace std;
+
+// Generator xorshift64 - kilka instrukcji na liczbę, stan w jednym słowie.
+// Do losowych rozgrywek, gdzie mt19937 byłby najdroższą częścią ruchu.
+struct FastRandom
+{
+    uint64_t state;
+
+    FastRandom(uint64_t seed);
+
+    uint64_t next();
+    int below(int n); // liczba z [0, n)
+};
+
+// Losowa rozgrywka do końca partii; pozycja zostaje na końcu rozgrywki.
+int randomPlayout(BitboardPosition &board, FastRandom &random);
+
+FastRandom::FastRandom(uint64_t seed)
+    : state(seed ? seed : 0x9E3779B97F4A7C15ULL)
+{
+}
+
+uint64_t FastRandom::next()
+{
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+}
+
+// mnożenie zamiast modulo - bez dzielenia, a skos rozkładu jest pomijalny
+int FastRandom::below(int n)
+{
+    return (int)(((next() >> 32) * (uint64_t)n) >> 32);
+}
+
+// Losowa rozgrywka do końca partii; wynik z perspektywy gracza na ruchu:
+// 1 wygrana, 0 remis, -1 przegrana. Gracz zawsze bierze wygraną, jeśli ją
+// ma, i blokuje wygraną rywala - rozgrywki bez tego są zbyt przypadkowe,
+// żeby wyniki coś mówiły. Pozostałe ruchy są losowe.
+int randomPlayout(BitboardPosition &board, FastRandom &random)
+{
+    int sign = 1;
+    while (board.getMoveCount() < board.getCells())
+    {
+        uint64_t possible = board.possibleMoves();
+        if (board.winningCells() & possible)
+            return sign;
+
+        uint64_t move = board.opponentWinningCells() & possible;
+        if (!move)
+        {
+            move = possible;
+            for (int skip = random.below(__builtin_popcountll(possible)); skip > 0; skip--)
+                move &= move - 1;
+        }
+        board.play(move & -move);
+        sign = -sign;
+    }
+    return 0;
+}
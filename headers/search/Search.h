@@ -0,0 +1,415 @@
+#pragma once
+#include <iostream>
+#include <climits>
+#include <atomic>
+#include <thread>
+#include <type_traits>
+#include "../game/Game.h"
+#include "../game/ConnectFour.h"
+#include "../game/BitboardConnectFour.h"
+#include "../game/FixedConnectFour.h"
+#include "TranspositionTable.h"
+#include "SearchLimits.h"
+#include "SearchThread.h"
+
+using namespace std;
+
+struct SearchOptions
+{
+    bool principalVariation = true;
+    int aspirationWindow = 5000; // połowa szerokości okna, 0 = pełne okno
+};
+
+// Rdzeń przeszukiwania (negamax) sparametryzowany konkretnym typem gry.
+// Dla klas gier oznaczonych final (ConnectFour, BitboardConnectFour,
+// FixedConnectFour) kompilator zna dokładny typ, więc makeMove/undoMove/
+// getEval są wołane bezpośrednio i mogą zostać wstawione. Search<Game>
+// działa dla dowolnej gry przez wywołania wirtualne.
+//
+// Jeden obiekt to jedno wyszukiwanie: gracze tworzą go w chooseMove,
+// a tablica transpozycji i stan wątków (kopie gry, heurystyki kolejności,
+// liczniki) należą do gracza i przeżywają kolejne ruchy.
+template <typename GameT>
+class Search
+{
+private:
+    const SearchLimits &limits;
+    TranspositionTable &table;
+    SearchOptions options;
+    vector<SearchThread> &workers; // workers[0] to wątek główny
+
+    chrono::high_resolution_clock::time_point searchStart;
+    atomic<bool> stopped{false};
+
+public:
+    Search(const SearchLimits &limits, TranspositionTable &table,
+           SearchOptions options, vector<SearchThread> &workers);
+
+    void run(const MoveList &validMoves, int emptyCells);
+    int searchMinimax(SearchThread &worker, int depth, const MoveList &validMoves, int &bestMove);
+
+private:
+    GameT &gameOf(SearchThread &worker);
+
+    void iterativeDeepening(SearchThread &worker, const MoveList &validMoves, int emptyCells);
+    int searchRoot(SearchThread &worker, int depth, int alpha, int beta,
+                   const MoveList &validMoves, int firstMove, int &bestMove);
+    int searchChild(SearchThread &worker, int depth, int ply, int alpha, int beta, bool firstChild);
+    int negamax(SearchThread &worker, int depth, int ply, int alpha, int beta);
+    int minimax(SearchThread &worker, int depth);
+    bool budgetExceeded(SearchThread &worker);
+};
+
+// Woła visit z grą rzutowaną na jej konkretny typ, a dla nieznanych
+// typów z samym Game&.
+template <typename Visitor>
+auto visitConcreteGame(Game &game, Visitor &&visit)
+{
+    if (auto *connectFour = dynamic_cast<ConnectFour *>(&game))
+        return visit(*connectFour);
+    if (auto *bitboard = dynamic_cast<BitboardConnectFour *>(&game))
+        return visit(*bitboard);
+    if (auto *fixed = dynamic_cast<ConnectFour6x7 *>(&game))
+        return visit(*fixed);
+    if (auto *fixed = dynamic_cast<ConnectFour7x8 *>(&game))
+        return visit(*fixed);
+    return visit(game);
+}
+
+template <typename GameT>
+Search<GameT>::Search(const SearchLimits &limits, TranspositionTable &table,
+                      SearchOptions options, vector<SearchThread> &workers)
+    : limits(limits),
+      table(table),
+      options(options),
+      workers(workers),
+      searchStart(chrono::high_resolution_clock::now())
+{
+}
+
+template <typename GameT>
+GameT &Search<GameT>::gameOf(SearchThread &worker)
+{
+    return static_cast<GameT &>(*worker.game);
+}
+
+// Iteracyjne pogłębianie na wszystkich wątkach (Lazy SMP). Wątek główny
+// kończy wyszukiwanie, pomocnicze kończą razem z nim.
+template <typename GameT>
+void Search<GameT>::run(const MoveList &validMoves, int emptyCells)
+{
+    vector<thread> helpers;
+    for (size_t i = 1; i < workers.size(); i++)
+    {
+        helpers.emplace_back([this, i, &validMoves, emptyCells]()
+                             { iterativeDeepening(workers[i], validMoves, emptyCells); });
+    }
+
+    iterativeDeepening(workers[0], validMoves, emptyCells);
+
+    stopped = true;
+    for (thread &helper : helpers)
+    {
+        helper.join();
+    }
+}
+
+// Pełne przeszukiwanie bez odcięć; wynik z perspektywy gracza na ruchu.
+template <typename GameT>
+int Search<GameT>::searchMinimax(SearchThread &worker, int depth, const MoveList &validMoves, int &bestMove)
+{
+    GameT &game = gameOf(worker);
+
+    int bestEvalDif = INT_MIN;
+    for (int move : validMoves)
+    {
+        if (!game.makeMove(move))
+        {
+            continue;
+        }
+
+        int evalDiff = -minimax(worker, depth - 1);
+        game.undoMove();
+
+        if (evalDiff > bestEvalDif)
+        {
+            bestEvalDif = evalDiff;
+            bestMove = move;
+        }
+    }
+    return bestEvalDif;
+}
+
+template <typename GameT>
+int Search<GameT>::minimax(SearchThread &worker, int depth)
+{
+    GameT &game = gameOf(worker);
+    worker.nodesVisited++;
+
+    char player = game.getCurrentPlayer();
+    char opponent = (player == 'X') ? 'O' : 'X';
+
+    if (depth == 0 || game.isTerminal())
+    {
+        return game.getEval(player) - game.getEval(opponent);
+    }
+
+    MoveList validMoves;
+    game.generateMoves(validMoves);
+
+    int maxEvalScore = -INT_MAX;
+    for (int move : validMoves)
+    {
+        game.makeMove(move);
+        int evalScore = -minimax(worker, depth - 1);
+        game.undoMove();
+        if (evalScore > maxEvalScore)
+            maxEvalScore = evalScore;
+    }
+    return maxEvalScore;
+}
+
+// Iteracyjne pogłębianie: wynik ostatniej pełnej iteracji jest ważny,
+// przerwana iteracja jest odrzucana. Najlepszy ruch poprzedniej iteracji
+// idzie na początek listy ruchów w korzeniu. Co drugi wątek pomocniczy
+// zaczyna o jeden poziom głębiej, żeby wątki nie szły krok w krok.
+//
+// Okno aspiracyjne jest ustawiane wokół wyniku iteracji o tej samej
+// parzystości głębokości - ocena na liściach faworyzuje gracza, który
+// zagrał ostatni, więc wyniki kolejnych iteracji skaczą na przemian.
+// Gdy wynik wypadnie poza okno, ta sama iteracja jest powtarzana z oknem
+// poszerzonym czterokrotnie po stronie porażki, aż do pełnego zakresu.
+template <typename GameT>
+void Search<GameT>::iterativeDeepening(SearchThread &worker, const MoveList &validMoves, int emptyCells)
+{
+    int parityEval[2] = {0, 0};
+    int parityDepth[2] = {0, 0};
+    for (int depth = 1 + worker.id % 2; depth <= limits.maxDepth; depth++)
+    {
+        worker.currentIteration = depth;
+
+        long long delta = options.aspirationWindow;
+        bool aspiration = options.aspirationWindow > 0 && parityDepth[depth % 2] > 0;
+        long long center = parityEval[depth % 2];
+        int alpha = aspiration ? (int)max<long long>(-INT_MAX, center - delta) : -INT_MAX;
+        int beta = aspiration ? (int)min<long long>(INT_MAX, center + delta) : INT_MAX;
+
+        int iterationMove = -1;
+        int iterationEval = 0;
+        while (true)
+        {
+            iterationMove = -1;
+            iterationEval = searchRoot(worker, depth, alpha, beta, validMoves, worker.bestMove, iterationMove);
+
+            if (stopped)
+                break;
+
+            if (iterationEval <= alpha && alpha > -INT_MAX)
+            {
+                delta *= 4;
+                alpha = (int)max<long long>(-INT_MAX, (long long)iterationEval - delta);
+            }
+            else if (iterationEval >= beta && beta < INT_MAX)
+            {
+                delta *= 4;
+                beta = (int)min<long long>(INT_MAX, (long long)iterationEval + delta);
+            }
+            else
+                break;
+
+            worker.aspirationResearches++;
+        }
+
+        if (stopped)
+            break;
+
+        worker.bestEval = iterationEval;
+        parityEval[depth % 2] = iterationEval;
+        parityDepth[depth % 2] = depth;
+        worker.bestMove = iterationMove;
+        worker.depthReached = depth;
+        worker.depthTime = chrono::duration_cast<chrono::microseconds>(
+            chrono::high_resolution_clock::now() - searchStart);
+
+        // głębiej niż do zapełnienia planszy drzewo już się nie zmienia
+        if (depth >= emptyCells)
+            break;
+    }
+}
+
+template <typename GameT>
+int Search<GameT>::searchRoot(SearchThread &worker, int depth, int alpha, int beta,
+                              const MoveList &validMoves, int firstMove, int &bestMove)
+{
+    GameT &game = gameOf(worker);
+
+    MoveList orderedMoves = validMoves;
+    char player = game.getCurrentPlayer();
+    worker.ordering.order(orderedMoves, 0, firstMove, player,
+                          game.winningColumns(player), game.winningColumns(player == 'X' ? 'O' : 'X'));
+
+    // wątki pomocnicze przestawiają ruchy za pierwszym, każdy o inną liczbę
+    for (int shift = 0; shift < worker.id % max(1, orderedMoves.size() - 1); shift++)
+    {
+        for (int i = 1; i + 1 < orderedMoves.size(); i++)
+            orderedMoves.swap(i, i + 1);
+    }
+
+    int bestEvalDif = -INT_MAX;
+
+    for (int i = 0; i < orderedMoves.size(); i++)
+    {
+        int move = orderedMoves[i];
+        if (!game.makeMove(move))
+        {
+            continue;
+        }
+
+        int evalDiff = searchChild(worker, depth - 1, 1, alpha, beta, bestMove == -1);
+        game.undoMove();
+
+        if (stopped)
+            return 0;
+
+        if (evalDiff > bestEvalDif || bestMove == -1)
+        {
+            bestEvalDif = evalDiff;
+            bestMove = move;
+        }
+        alpha = max(alpha, bestEvalDif);
+
+        if (beta <= alpha)
+            break;
+    }
+
+    return bestEvalDif;
+}
+
+// Wynik ruchu, który właśnie zagrano, z perspektywy gracza przed ruchem.
+// W trybie PVS tylko pierwszy ruch dostaje pełne okno; reszta ma udowodnić
+// zerowym oknem, że nie jest lepsza od alfy, a jeśli jest (i nie daje od
+// razu odcięcia), jest przeszukiwana ponownie z pełnym oknem.
+template <typename GameT>
+int Search<GameT>::searchChild(SearchThread &worker, int depth, int ply, int alpha, int beta, bool firstChild)
+{
+    if (!options.principalVariation || firstChild || beta - (long long)alpha <= 1)
+        return -negamax(worker, depth, ply, -beta, -alpha);
+
+    int evalScore = -negamax(worker, depth, ply, -alpha - 1, -alpha);
+    if (evalScore > alpha && evalScore < beta && !stopped.load(memory_order_relaxed))
+    {
+        worker.pvsResearches++;
+        evalScore = -negamax(worker, depth, ply, -beta, -alpha);
+    }
+    return evalScore;
+}
+
+// Budżet pilnuje tylko wątek główny i liczy w nim własne węzły, więc przy
+// jednym wątku budżet węzłów jest w pełni deterministyczny. Sprawdzany jest
+// dopiero od drugiej iteracji, żeby zawsze był jakiś ruch; zegar
+// odpytujemy co 1024 węzły.
+template <typename GameT>
+bool Search<GameT>::budgetExceeded(SearchThread &worker)
+{
+    if (stopped.load(memory_order_relaxed))
+        return true;
+    if (worker.id != 0 || worker.currentIteration == 1 || !limits.hasBudget())
+        return false;
+
+    if (limits.nodeBudget > 0 && worker.nodesVisited >= limits.nodeBudget)
+        stopped = true;
+    else if (limits.timeBudget.count() > 0 && (worker.nodesVisited & 1023) == 0 &&
+             chrono::high_resolution_clock::now() - searchStart >= limits.timeBudget)
+        stopped = true;
+
+    return stopped.load(memory_order_relaxed);
+}
+
+// Negamax: wynik zawsze z perspektywy gracza na ruchu w danej pozycji,
+// dzięki czemu wpisy w tablicy transpozycji nie zależą od tego, kto szuka.
+template <typename GameT>
+int Search<GameT>::negamax(SearchThread &worker, int depth, int ply, int alpha, int beta)
+{
+    GameT &game = gameOf(worker);
+
+    worker.nodesVisited++;
+    if (budgetExceeded(worker))
+        return 0;
+
+    char player = game.getCurrentPlayer();
+    char opponent = (player == 'X') ? 'O' : 'X';
+
+    if (depth == 0 || game.isTerminal())
+    {
+        return game.getEval(player) - game.getEval(opponent);
+    }
+
+    int alphaOrig = alpha;
+    // pozycja i jej odbicie dzielą wpis; ruch w tablicy jest w orientacji kanonicznej
+    uint64_t key = game.getCanonicalHash();
+    int hashMove = 0;
+
+    if (table.isEnabled())
+    {
+        TTEntry entry;
+        worker.ttProbes++;
+        if (table.probe(key, entry))
+        {
+            worker.ttHits++;
+            if (table.isFromEarlierSearch(entry))
+                worker.ttReusedHits++;
+            hashMove = game.canonicalMove(entry.bestMove);
+            if (entry.depth >= depth &&
+                (entry.bound == BOUND_EXACT ||
+                 (entry.bound == BOUND_LOWER && entry.score >= beta) ||
+                 (entry.bound == BOUND_UPPER && entry.score <= alpha)))
+            {
+                worker.ttCutoffs++;
+                return entry.score;
+            }
+        }
+    }
+
+    MoveList validMoves;
+    game.generateMoves(validMoves);
+    worker.ordering.order(validMoves, ply, hashMove, player,
+                          game.winningColumns(player), game.winningColumns(opponent));
+
+    int maxEvalScore = -INT_MAX;
+    int bestMove = 0;
+    for (int i = 0; i < validMoves.size(); i++)
+    {
+        int move = validMoves[i];
+        game.makeMove(move);
+        int evalScore = searchChild(worker, depth - 1, ply + 1, alpha, beta, i == 0);
+        game.undoMove();
+
+        if (stopped.load(memory_order_relaxed))
+            return 0;
+
+        if (evalScore > maxEvalScore)
+        {
+            maxEvalScore = evalScore;
+            bestMove = move;
+        }
+        alpha = max(alpha, evalScore);
+
+        if (beta <= alpha)
+        {
+            worker.prunedBranches++;
+            if (i == 0)
+                worker.firstMoveCutoffs++;
+            worker.ordering.recordCutoff(move, ply, depth, player);
+            break;
+        }
+    }
+
+    BoundType bound = BOUND_EXACT;
+    if (maxEvalScore <= alphaOrig)
+        bound = BOUND_UPPER;
+    else if (maxEvalScore >= beta)
+        bound = BOUND_LOWER;
+    table.store(key, depth, bound, maxEvalScore, game.canonicalMove(bestMove));
+
+    return maxEvalScore;
+}
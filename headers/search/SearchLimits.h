@@ -0,0 +1,42 @@
+#pragma once
+#include <iostream>
+#include <chrono>
+#include <algorithm>
+
+using namespace std;
+
+// Ograniczenia jednego wyszukiwania. Zero w budżecie oznacza brak limitu.
+// Budżet węzłów jest deterministyczny (przydatny w benchmarkach), budżet
+// czasu ogranicza opóźnienie ruchu w prawdziwej grze.
+struct SearchLimits
+{
+    int maxDepth;
+    chrono::milliseconds timeBudget;
+    long long nodeBudget;
+
+    SearchLimits(int maxDepth = 3,
+                 chrono::milliseconds timeBudget = chrono::milliseconds(0),
+                 long long nodeBudget = 0)
+        : maxDepth(maxDepth),
+          timeBudget(timeBudget),
+          nodeBudget(nodeBudget) {}
+
+    bool hasBudget() const
+    {
+        return timeBudget.count() > 0 || nodeBudget > 0;
+    }
+
+    // Budżet, który zostaje po zużyciu elapsed czasu i nodes węzłów. Nigdy
+    // nie spada do zera, bo zero znaczyłoby brak limitu - wyczerpany budżet
+    // to 1 ms / 1 węzeł, czyli tylko pierwsza iteracja.
+    SearchLimits remaining(chrono::microseconds elapsed, long long nodes) const
+    {
+        SearchLimits rest = *this;
+        if (timeBudget.count() > 0)
+            rest.timeBudget = max(chrono::milliseconds(1),
+                                  timeBudget - chrono::duration_cast<chrono::milliseconds>(elapsed));
+        if (nodeBudget > 0)
+            rest.nodeBudget = max(1LL, nodeBudget - nodes);
+        return rest;
+    }
+};
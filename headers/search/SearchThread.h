@@ -0,0 +1,53 @@
+#pragma once
+#include <iostream>
+#include <memory>
+#include <chrono>
+#include "../game/Game.h"
+#include "MoveOrdering.h"
+
+using namespace std;
+
+// Stan jednego wątku przeszukiwania: własna kopia gry, własne heurystyki
+// kolejności i własne liczniki. Wątek pisze tylko do swojej struktury,
+// a wyrównanie do linii cache chroni liczniki przed false sharing;
+// sumujemy je dopiero po zakończeniu wyszukiwania.
+struct alignas(64) SearchThread
+{
+    int id = 0;
+    unique_ptr<Game> game;
+    MoveOrdering ordering;
+
+    int nodesVisited = 0;
+    int prunedBranches = 0;
+    int firstMoveCutoffs = 0;
+    int ttProbes = 0;
+    int ttHits = 0;
+    int ttReusedHits = 0; // trafienia we wpisy z poprzednich ruchów
+    int ttCutoffs = 0;
+    int pvsResearches = 0;
+    int aspirationResearches = 0;
+
+    int currentIteration = 0;
+    int depthReached = 0;
+    chrono::microseconds depthTime{0}; // od startu wyszukiwania do ukończenia depthReached
+    int bestMove = -1;
+    int bestEval = 0;
+
+    void clearCounters()
+    {
+        nodesVisited = 0;
+        prunedBranches = 0;
+        firstMoveCutoffs = 0;
+        ttProbes = 0;
+        ttHits = 0;
+        ttReusedHits = 0;
+        ttCutoffs = 0;
+        pvsResearches = 0;
+        aspirationResearches = 0;
+        currentIteration = 0;
+        depthReached = 0;
+        depthTime = chrono::microseconds(0);
+        bestMove = -1;
+        bestEval = 0;
+    }
+};
@@ -0,0 +1,321 @@
+#pragma once
+#include <iostream>
+#include <chrono>
+#include <cstdint>
+#include <algorithm>
+#include <cstdlib>
+#include "../game/Game.h"
+#include "../game/BitboardPosition.h"
+#include "TranspositionTable.h"
+#include "SearchLimits.h"
+
+using namespace std;
+
+// Dokładna wartość pozycji z perspektywy gracza na ruchu.
+//
+// Wynik jak w klasycznym solverze Connect Four: wygrana to
+// (pola + 1 - ruchy przed wygrywającym ruchem) / 2, czyli im szybciej, tym
+// więcej; przegrana to wartość ujemna, remis 0.
+struct SolveResult
+{
+    bool solved = false; // false, gdy skończył się budżet
+    int score = 0;
+    int bestMove = 0; // kolumna od 1
+    int plies = 0;    // ruchy obu graczy do końca partii przy najlepszej grze
+    long long nodes = 0;
+
+    char outcome() const; // 'W', 'D' albo 'L'
+};
+
+// Solver dla planszy mieszczącej się w masce bitowej (cols * (rows + 1) <= 64,
+// standardowe 6x7 też). Pozycja jest trzymana w BitboardPosition.
+//
+// Szukanie to negamax z zerowym oknem: wartość jest zawężana wyszukiwaniem
+// binarnym po granicy okna, a każde wywołanie odpowiada tylko "lepiej czy
+// gorzej niż x". Pomagają w tym:
+// - ruchy, po których rywal wygrywa od razu, są pomijane, a wymuszona
+//   obrona jest jedynym ruchem;
+// - ruchy są ustawione według liczby nowych pól wygrywających, a remisy
+//   rozstrzyga odległość od środka;
+// - tablica transpozycji trzyma granice wartości; są one dokładne, więc
+//   wpisy zostają ważne także w kolejnych wywołaniach solve. Pozycja i jej
+//   odbicie lewo-prawo mają tę samą wartość i dzielą jeden wpis.
+class Solver
+{
+private:
+    BitboardPosition position;
+    int cells = 0;
+
+    TranspositionTable table;
+    SearchLimits limits;
+    chrono::high_resolution_clock::time_point searchStart;
+    long long nodes = 0;
+    bool stopped = false;
+
+public:
+    Solver(int ttSizeMB = 64);
+
+    static bool fitsBoard(int rows, int cols);
+
+    SolveResult solve(const Game &game, const SearchLimits &limits = SearchLimits());
+    void clear();
+
+private:
+    void load(const Game &game);
+
+    int solvePosition();
+    int negamax(int alpha, int beta);
+    int pliesToEnd(int score) const;
+    bool budgetExceeded();
+};
+
+char SolveResult::outcome() const
+{
+    return score > 0 ? 'W' : score < 0 ? 'L' : 'D';
+}
+
+Solver::Solver(int ttSizeMB)
+    : table(ttSizeMB)
+{
+}
+
+bool Solver::fitsBoard(int rows, int cols)
+{
+    return BitboardPosition::fitsBoard(rows, cols);
+}
+
+void Solver::clear()
+{
+    table.clear();
+}
+
+void Solver::load(const Game &game)
+{
+    // wpisy z innej planszy miałyby te same klucze dla innych pozycji
+    if (position.setBoardSize(game.getRows(), game.getCols()))
+        table.clear();
+
+    position.load(game);
+    cells = position.getCells();
+}
+
+SolveResult Solver::solve(const Game &game, const SearchLimits &searchLimits)
+{
+    SolveResult result;
+    if (!fitsBoard(game.getRows(), game.getCols()))
+    {
+        printf("Plansza %dx%d nie mieści się w masce bitowej solvera.\n", game.getRows(), game.getCols());
+        return result;
+    }
+
+    load(game);
+    limits = searchLimits;
+    searchStart = chrono::high_resolution_clock::now();
+    nodes = 0;
+    stopped = false;
+
+    if (position.getMoveCount() >= cells || game.isLastMoveWin())
+    {
+        result.solved = true;
+        return result;
+    }
+
+    int value = solvePosition();
+    int cols = position.getCols();
+    bool symmetric = position.isSymmetric();
+
+    // ruch osiągający wartość: sprawdzenie zerowym oknem, czy dziecko daje >= value;
+    // w pozycji symetrycznej prawa połowa to odbicia lewej
+    for (int i = 0; i < cols && !stopped; i++)
+    {
+        int col = position.orderedColumn(i);
+        uint64_t move = position.columnMove(col);
+        if (!move || (symmetric && col > cols - 1 - col))
+            continue;
+
+        int score;
+        if (position.isWinningMove(move))
+        {
+            score = (cells + 1 - position.getMoveCount()) / 2;
+        }
+        else
+        {
+            position.play(move);
+            if (position.canWinNext())
+                score = -(cells + 1 - position.getMoveCount()) / 2;
+            else
+                score = -negamax(-value, -value + 1);
+            position.undo(move);
+        }
+
+        if (score >= value)
+        {
+            result.bestMove = col + 1;
+            break;
+        }
+    }
+
+    result.nodes = nodes;
+    if (stopped || result.bestMove == 0)
+        return result;
+
+    result.solved = true;
+    result.score = value;
+    result.plies = pliesToEnd(value);
+    return result;
+}
+
+// Wartość bieżącej pozycji: przedział [minScore, maxScore] zawężany zerowymi
+// oknami, najpierw wokół zera, żeby szybko rozstrzygnąć wygraną / przegraną.
+int Solver::solvePosition()
+{
+    int moves = position.getMoveCount();
+    if (position.canWinNext())
+        return (cells + 1 - moves) / 2;
+
+    int minScore = -(cells - moves) / 2;
+    int maxScore = (cells + 1 - moves) / 2;
+    while (minScore < maxScore && !stopped)
+    {
+        int med = minScore + (maxScore - minScore) / 2;
+        if (med <= 0 && minScore / 2 < med)
+            med = minScore / 2;
+        else if (med >= 0 && maxScore / 2 > med)
+            med = maxScore / 2;
+
+        int score = negamax(med, med + 1);
+        if (score <= med)
+            maxScore = score;
+        else
+            minScore = score;
+    }
+    return minScore;
+}
+
+// Zakłada, że gracz na ruchu nie może wygrać od razu (sprawdza to wołający).
+int Solver::negamax(int alpha, int beta)
+{
+    nodes++;
+    if (budgetExceeded())
+        return 0;
+
+    int moves = position.getMoveCount();
+    uint64_t next = position.nonLosingMoves();
+    if (!next)
+        return -(cells - moves) / 2;
+
+    if (moves >= cells - 2)
+        return 0;
+
+    // rywal nie wygra w następnym ruchu, my najwcześniej za dwa
+    int minScore = -(cells - 2 - moves) / 2;
+    if (alpha < minScore)
+    {
+        alpha = minScore;
+        if (alpha >= beta)
+            return alpha;
+    }
+
+    int maxScore = (cells - 1 - moves) / 2;
+    if (beta > maxScore)
+    {
+        beta = maxScore;
+        if (alpha >= beta)
+            return beta;
+    }
+
+    uint64_t key = position.key();
+    TTEntry entry;
+    if (table.probe(key, entry))
+    {
+        if (entry.bound == BOUND_LOWER)
+        {
+            if (alpha < entry.score)
+            {
+                alpha = entry.score;
+                if (alpha >= beta)
+                    return alpha;
+            }
+        }
+        else if (beta > entry.score)
+        {
+            beta = entry.score;
+            if (alpha >= beta)
+                return beta;
+        }
+    }
+
+    // sortowanie przez wstawianie po liczbie pól wygrywających po ruchu;
+    // stabilne, więc przy remisie zostaje kolejność od środka
+    uint64_t moveBits[Game::MAX_SIZE];
+    int moveScores[Game::MAX_SIZE];
+    int count = 0;
+    for (int i = 0; i < position.getCols(); i++)
+    {
+        uint64_t move = next & position.columnMask(position.orderedColumn(i));
+        if (!move)
+            continue;
+
+        int score = position.threatsAfter(move);
+        int j = count++;
+        for (; j > 0 && moveScores[j - 1] < score; j--)
+        {
+            moveBits[j] = moveBits[j - 1];
+            moveScores[j] = moveScores[j - 1];
+        }
+        moveBits[j] = move;
+        moveScores[j] = score;
+    }
+
+    for (int i = 0; i < count; i++)
+    {
+        position.play(moveBits[i]);
+        int score = -negamax(-beta, -alpha);
+        position.undo(moveBits[i]);
+
+        if (stopped)
+            return 0;
+
+        if (score >= beta)
+        {
+            table.store(key, 0, BOUND_LOWER, score, 0);
+            return score;
+        }
+        alpha = max(alpha, score);
+    }
+
+    table.store(key, 0, BOUND_UPPER, alpha, 0);
+    return alpha;
+}
+
+// Ruchy obu graczy do końca partii; wynik s odpowiada wygranej, przed którą
+// zagrano pola + 1 - 2s albo pola - 2s ruchów - tę z właściwą parzystością.
+int Solver::pliesToEnd(int score) const
+{
+    int moves = position.getMoveCount();
+    if (score == 0)
+        return cells - moves;
+
+    int winnerParity = score > 0 ? moves % 2 : (moves + 1) % 2;
+    int s = abs(score);
+    int before = cells + 1 - 2 * s;
+    if (before % 2 != winnerParity)
+        before--;
+    return before - moves + 1;
+}
+
+bool Solver::budgetExceeded()
+{
+    if (stopped)
+        return true;
+    if (!limits.hasBudget())
+        return false;
+
+    if (limits.nodeBudget > 0 && nodes >= limits.nodeBudget)
+        stopped = true;
+    else if (limits.timeBudget.count() > 0 && (nodes & 1023) == 0 &&
+             chrono::high_resolution_clock::now() - searchStart >= limits.timeBudget)
+        stopped = true;
+
+    return stopped;
+}
@@ -0,0 +1,168 @@
+#pragma once
+#include <iostream>
+#include <memory>
+#include <atomic>
+#include <cstdint>
+#include <algorithm>
+
+using namespace std;
+
+enum BoundType : uint8_t
+{
+    BOUND_EXACT, // dokładna wartość
+    BOUND_LOWER, // wartość >= score (odcięcie beta)
+    BOUND_UPPER  // wartość <= score (żaden ruch nie poprawił alfy)
+};
+
+struct TTEntry
+{
+    int32_t score = 0;
+    int16_t depth = -1;
+    BoundType bound = BOUND_EXACT;
+    uint8_t bestMove = 0; // kolumna od 1, 0 = brak
+    uint8_t generation = 0;
+};
+
+// Tablica transpozycji o stałym rozmiarze, indeksowana hashem pozycji.
+// Wyniki są zapisywane z perspektywy gracza na ruchu.
+//
+// Polityka zastępowania: każdy hash ma jedno miejsce (key & mask). Wpis jest
+// nadpisywany, gdy jest pusty, pochodzi sprzed co najmniej dwóch wyszukiwań
+// albo nowy wynik ma co najmniej taką samą głębokość. Płytszy wynik nie
+// wypiera więc głębszego z bieżącego ani z poprzedniego ruchu - inaczej
+// pierwsze, płytkie iteracje nowego wyszukiwania zamazałyby to, co
+// poprzednie policzyło najgłębiej.
+//
+// Odczyt nie patrzy na generację: wynik zależy tylko od pozycji
+// i głębokości, więc wpisy z poprzednich ruchów tej samej partii są dalej
+// poprawne - nowy korzeń to zwykle wnuk starego, a jego poddrzewo jest już
+// w tablicy. Generacja decyduje tylko o tym, co można nadpisać.
+//
+// Tablica jest bez blokad i może być współdzielona przez wątki: wpis to dwa
+// słowa atomowe, dane i (klucz XOR dane). Jeśli dwa wątki zapiszą to samo
+// miejsce jednocześnie i słowa się "pomieszają", XOR nie da klucza
+// i odczyt potraktuje wpis jak pusty.
+class TranspositionTable
+{
+private:
+    struct Slot
+    {
+        atomic<uint64_t> keyXorData{0};
+        atomic<uint64_t> data{0};
+    };
+
+    unique_ptr<Slot[]> slots;
+    size_t count = 0;
+    uint64_t mask = 0;
+    uint8_t generation = 0;
+
+public:
+    TranspositionTable(int sizeMB);
+
+    bool isEnabled() const;
+    void newSearch();
+    void clear();
+    bool isFromEarlierSearch(const TTEntry &entry) const;
+
+    bool probe(uint64_t key, TTEntry &entry) const;
+    void store(uint64_t key, int depth, BoundType bound, int score, int bestMove);
+
+private:
+    // bity: 0-31 wynik, 32-39 głębokość + 1 (0 = pusty, najwyżej 254), 40-41 typ,
+    // 42-49 najlepszy ruch, 50-57 generacja
+    static uint64_t pack(int depth, BoundType bound, int score, int bestMove, uint8_t generation);
+    static TTEntry unpack(uint64_t data);
+};
+
+TranspositionTable::TranspositionTable(int sizeMB)
+{
+    if (sizeMB <= 0)
+        return;
+
+    // największa potęga dwójki wpisów mieszcząca się w budżecie
+    count = 1;
+    while (count * 2 * sizeof(Slot) <= (size_t)sizeMB * 1024 * 1024)
+        count *= 2;
+
+    slots = make_unique<Slot[]>(count);
+    mask = count - 1;
+}
+
+bool TranspositionTable::isEnabled() const
+{
+    return count > 0;
+}
+
+void TranspositionTable::newSearch()
+{
+    generation++;
+}
+
+void TranspositionTable::clear()
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        slots[i].keyXorData.store(0, memory_order_relaxed);
+        slots[i].data.store(0, memory_order_relaxed);
+    }
+    generation = 0;
+}
+
+bool TranspositionTable::isFromEarlierSearch(const TTEntry &entry) const
+{
+    return entry.generation != generation;
+}
+
+uint64_t TranspositionTable::pack(int depth, BoundType bound, int score, int bestMove, uint8_t generation)
+{
+    return (uint64_t)(uint32_t)score |
+           (uint64_t)(uint8_t)(min(depth, 254) + 1) << 32 |
+           (uint64_t)bound << 40 |
+           (uint64_t)(uint8_t)max(bestMove, 0) << 42 |
+           (uint64_t)generation << 50;
+}
+
+TTEntry TranspositionTable::unpack(uint64_t data)
+{
+    TTEntry entry;
+    entry.score = (int32_t)(uint32_t)data;
+    entry.depth = (int)((data >> 32) & 0xFF) - 1;
+    entry.bound = (BoundType)((data >> 40) & 0x3);
+    entry.bestMove = (data >> 42) & 0xFF;
+    entry.generation = (data >> 50) & 0xFF;
+    return entry;
+}
+
+bool TranspositionTable::probe(uint64_t key, TTEntry &entry) const
+{
+    if (!count)
+        return false;
+
+    const Slot &slot = slots[key & mask];
+    uint64_t data = slot.data.load(memory_order_relaxed);
+    uint64_t keyXorData = slot.keyXorData.load(memory_order_relaxed);
+    if ((keyXorData ^ data) != key)
+        return false;
+
+    TTEntry found = unpack(data);
+    if (found.depth < 0)
+        return false;
+
+    entry = found;
+    return true;
+}
+
+void TranspositionTable::store(uint64_t key, int depth, BoundType bound, int score, int bestMove)
+{
+    if (!count)
+        return;
+
+    Slot &slot = slots[key & mask];
+    TTEntry old = unpack(slot.data.load(memory_order_relaxed));
+    if (old.depth >= 0 && (uint8_t)(generation - old.generation) <= 1 && depth < old.depth)
+        return;
+
+    uint64_t data = pack(depth, bound, score, bestMove, generation);
+    slot.data.store(data, memory_order_relaxed);
+    slot.keyXorData.store(key ^ data, memory_order_relaxed);
+}
@@ -0,0 +1,287 @@
+#pragma once
+#include <iostream>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <chrono>
+
+using namespace std;
+
+// Grupa zadań, na której zakończenie można poczekać.
+struct TaskGroup
+{
+    atomic<int> pending{0};
+};
+
+// Pula wątków z kradzieżą pracy. Każdy wątek ma własną kolejkę: właściciel
+// dokłada i zdejmuje zadania z końca (LIFO - najpierw najgłębsze), a wątek
+// bez pracy kradnie z początku cudzej kolejki (najstarsze, zwykle największe
+// poddrzewa). Wątek, który wywołuje begin()/wait(), jest pracownikiem 0;
+// pozostałe są tworzone w konstruktorze i śpią, dopóki pula nie jest aktywna.
+class WorkStealingPool
+{
+private:
+    struct QueuedTask
+    {
+        function<void()> run;
+        TaskGroup *group;
+    };
+
+    struct alignas(64) Worker
+    {
+        mutex lock;
+        deque<QueuedTask> tasks;
+        long long steals = 0;
+        chrono::microseconds idleTime{0};
+        uint64_t random = 0;
+    };
+
+    vector<unique_ptr<Worker>> workers;
+    vector<thread> threads;
+
+    mutex stateLock;
+    condition_variable wakeUp;
+    condition_variable parked;
+    int running = 0; // pomocnicy poza uśpieniem
+    bool active = false;
+    bool shutdown = false;
+
+    static thread_local WorkStealingPool *currentPool;
+    static thread_local int currentIndex;
+
+public:
+    WorkStealingPool(int threadCount);
+    ~WorkStealingPool();
+
+    int size() const;
+    int currentWorker() const;
+
+    void begin();
+    void end();
+
+    void spawn(TaskGroup &group, function<void()> task);
+    void wait(TaskGroup &group);
+
+    long long getSteals() const;
+    chrono::microseconds getIdleTime() const;
+    void resetStats();
+
+private:
+    void workerLoop(int index);
+    bool runOneTask(int index);
+    bool popOwn(int index, QueuedTask &task);
+    bool steal(int index, QueuedTask &task);
+};
+
+thread_local WorkStealingPool *WorkStealingPool::currentPool = nullptr;
+thread_local int WorkStealingPool::currentIndex = 0;
+
+WorkStealingPool::WorkStealingPool(int threadCount)
+{
+    int count = max(1, threadCount);
+    for (int i = 0; i < count; i++)
+    {
+        workers.push_back(make_unique<Worker>());
+        workers[i]->random = 0x9E3779B97F4A7C15ULL * (i + 1);
+    }
+    for (int i = 1; i < count; i++)
+    {
+        threads.emplace_back([this, i]()
+                             { workerLoop(i); });
+    }
+}
+
+WorkStealingPool::~WorkStealingPool()
+{
+    {
+        lock_guard<mutex> guard(stateLock);
+        shutdown = true;
+    }
+    wakeUp.notify_all();
+    for (thread &t : threads)
+    {
+        t.join();
+    }
+}
+
+int WorkStealingPool::size() const
+{
+    return workers.size();
+}
+
+int WorkStealingPool::currentWorker() const
+{
+    return currentPool == this ? currentIndex : 0;
+}
+
+// Budzi pomocników na czas jednego wyszukiwania; wywołujący staje się pracownikiem 0.
+void WorkStealingPool::begin()
+{
+    currentPool = this;
+    currentIndex = 0;
+    {
+        lock_guard<mutex> guard(stateLock);
+        active = true;
+    }
+    wakeUp.notify_all();
+}
+
+// Po powrocie żaden pomocnik już nie pracuje, więc statystyki można czytać.
+void WorkStealingPool::end()
+{
+    unique_lock<mutex> guard(stateLock);
+    active = false;
+    parked.wait(guard, [this]()
+                { return running == 0; });
+}
+
+void WorkStealingPool::spawn(TaskGroup &group, function<void()> task)
+{
+    group.pending++;
+    Worker &worker = *workers[currentWorker()];
+    lock_guard<mutex> guard(worker.lock);
+    worker.tasks.push_back(QueuedTask{move(task), &group});
+}
+
+// Czekając na grupę, wątek nie śpi, tylko sam wykonuje zadania - własne
+// albo ukradzione - więc zagnieżdżone podziały nie blokują puli.
+void WorkStealingPool::wait(TaskGroup &group)
+{
+    int index = currentWorker();
+    while (group.pending.load() > 0)
+    {
+        if (!runOneTask(index))
+        {
+            auto idleStart = chrono::high_resolution_clock::now();
+            this_thread::yield();
+            workers[index]->idleTime += chrono::duration_cast<chrono::microseconds>(
+                chrono::high_resolution_clock::now() - idleStart);
+        }
+    }
+}
+
+long long WorkStealingPool::getSteals() const
+{
+    long long total = 0;
+    for (const auto &worker : workers)
+        total += worker->steals;
+    return total;
+}
+
+chrono::microseconds WorkStealingPool::getIdleTime() const
+{
+    chrono::microseconds total{0};
+    for (const auto &worker : workers)
+        total += worker->idleTime;
+    return total;
+}
+
+// Wywoływać tylko poza wyszukiwaniem (między end() a begin()).
+void WorkStealingPool::resetStats()
+{
+    for (auto &worker : workers)
+    {
+        worker->steals = 0;
+        worker->idleTime = chrono::microseconds(0);
+    }
+}
+
+void WorkStealingPool::workerLoop(int index)
+{
+    currentPool = this;
+    currentIndex = index;
+
+    while (true)
+    {
+        {
+            unique_lock<mutex> guard(stateLock);
+            wakeUp.wait(guard, [this]()
+                        { return active || shutdown; });
+            if (shutdown)
+                return;
+            running++;
+        }
+
+        // pracujemy, dopóki pula jest aktywna
+        while (true)
+        {
+            if (runOneTask(index))
+                continue;
+
+            {
+                lock_guard<mutex> guard(stateLock);
+                if (!active || shutdown)
+                {
+                    running--;
+                    parked.notify_all();
+                    break;
+                }
+            }
+
+            auto idleStart = chrono::high_resolution_clock::now();
+            this_thread::yield();
+            workers[index]->idleTime += chrono::duration_cast<chrono::microseconds>(
+                chrono::high_resolution_clock::now() - idleStart);
+        }
+    }
+}
+
+bool WorkStealingPool::runOneTask(int index)
+{
+    QueuedTask task;
+    if (!popOwn(index, task) && !steal(index, task))
+        return false;
+
+    task.run();
+    task.group->pending--;
+    return true;
+}
+
+bool WorkStealingPool::popOwn(int index, QueuedTask &task)
+{
+    Worker &worker = *workers[index];
+    lock_guard<mutex> guard(worker.lock);
+    if (worker.tasks.empty())
+        return false;
+
+    task = move(worker.tasks.back());
+    worker.tasks.pop_back();
+    return true;
+}
+
+bool WorkStealingPool::steal(int index, QueuedTask &task)
+{
+    int count = workers.size();
+    if (count == 1)
+        return false;
+
+    // losowa ofiara (xorshift), potem kolejne po kolei
+    uint64_t &random = workers[index]->random;
+    random ^= random << 13;
+    random ^= random >> 7;
+    random ^= random << 17;
+    int start = random % count;
+
+    for (int i = 0; i < count; i++)
+    {
+        int victimIndex = (start + i) % count;
+        if (victimIndex == index)
+            continue;
+
+        Worker &victim = *workers[victimIndex];
+        lock_guard<mutex> guard(victim.lock);
+        if (victim.tasks.empty())
+            continue;
+
+        task = move(victim.tasks.front());
+        victim.tasks.pop_front();
+        workers[index]->steals++;
+        return true;
+    }
+    return false;
+}
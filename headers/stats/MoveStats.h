@@ -11,6 +11,45 @@ struct MoveStats
   chrono::microseconds timeTaken;
   int chosenMove;
   int evalScore;
+  int depthReached = 0;
+  int firstMoveCutoffs = 0; // odcięcia już po pierwszym ruchu (z prunedBranches)
+
+  // tablica transpozycji (AlphaBetaPlayer)
+  int ttProbes = 0;
+  int ttHits = 0;
+  int ttCutoffs = 0;
+
+  // część pracy przejęta z poprzedniego ruchu: trafienia TT we wpisy
+  // z wcześniejszych wyszukiwań (AlphaBeta, YBW) albo wizyty korzenia
+  // odziedziczone z poprzedniego drzewa (MCTS)
+  double reusedFraction = 0.0;
+
+  // PVS i okna aspiracyjne (AlphaBetaPlayer)
+  int pvsResearches = 0;        // ponowne przeszukania po nieudanym zerowym oknie
+  int aspirationResearches = 0; // powtórzone iteracje po wyjściu poza okno
+
+  // przeszukiwanie równoległe
+  int threadsUsed = 1;
+  // czas dojścia do depthReached jednym wątkiem względem wszystkich, z tej
+  // samej pozycji i pustej tablicy; 0 = nie mierzono (tylko tryb pomiarowy
+  // AlphaBetaPlayer::setSpeedupBenchmark)
+  double parallelSpeedup = 0.0;
+
+  bool fromBook = false; // ruch z księgi otwarć, bez przeszukiwania
+
+  // dokładne rozwiązanie (SolverPlayer, końcówka AlphaBetaPlayer);
+  // evalScore to wtedy wynik solvera
+  bool solved = false;
+  int pliesToEnd = 0;                // ruchy obu graczy do końca partii przy najlepszej grze
+  chrono::microseconds solveTime{0}; // czas w solverze, także nieudanej próby
+
+  // MCTSPlayer; evalScore to wtedy średni wynik ruchu w promilach
+  double playoutsPerSecond = 0.0;
+  int treeNodes = 0;
+
+  // pula z kradzieżą pracy (YBWPlayer)
+  long long steals = 0;
+  chrono::microseconds idleTime{0}; // suma po wątkach czasu bez zadania
 
   MoveStats() : nodesVisited(0), prunedBranches(0),
                 timeTaken(0), chosenMove(-1), evalScore(0) {}
@@ -23,4 +62,9 @@ struct MoveStats
         timeTaken(time),
         chosenMove(move),
         evalScore(0) {}
-};
\ No newline at end of file
+
+  double firstMoveCutoffRate() const
+  {
+    return prunedBranches > 0 ? (double)firstMoveCutoffs / prunedBranches : 0.0;
+  }
+};
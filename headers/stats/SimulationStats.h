@@ -13,11 +13,15 @@ struct MoveAvgStats
     double prunedBranches;
     chrono::microseconds timeTaken;
     int gamesReached;
+    double ttHits;
+    double ttCutoffs;
 
     MoveAvgStats() : nodesVisited(0),
                      prunedBranches(0),
                      timeTaken(0),
-                     gamesReached(0) {}
+                     gamesReached(0),
+                     ttHits(0),
+                     ttCutoffs(0) {}
 };
 
 struct SimulationStats
@@ -46,6 +50,8 @@ struct SimulationStats
                 avg.nodesVisited += mStats.nodesVisited;
                 avg.prunedBranches += mStats.prunedBranches;
                 avg.timeTaken += mStats.timeTaken;
+                avg.ttHits += mStats.ttHits;
+                avg.ttCutoffs += mStats.ttCutoffs;
                 avg.gamesReached++;
             }
         }
@@ -56,6 +62,8 @@ struct SimulationStats
             {
                 avg.nodesVisited /= avg.gamesReached;
                 avg.prunedBranches /= avg.gamesReached;
+                avg.ttHits /= avg.gamesReached;
+                avg.ttCutoffs /= avg.gamesReached;
                 avg.timeTaken = chrono::microseconds(
                     avg.timeTaken.count() / avg.gamesReached);
             }
@@ -1,16 +1,30 @@
 #include <iostream>
 #include "headers/manager/GameManager.h"
 #include "headers/game/ConnectFour.h"
+#include "headers/game/BitboardConnectFour.h"
+#include "headers/game/FixedConnectFour.h"
+#include "headers/manager/BackendTester.h"
+#include "headers/manager/BookGenerator.h"
 #include "headers/ai_players/RandomPlayer.h"
 #include "headers/ai_players/GreedyPlayer.h"
 #include "headers/ai_players/MinimaxPlayer.h"
 #include "headers/ai_players/AlphaBetaPlayer.h"
+#include "headers/ai_players/YBWPlayer.h"
+#include "headers/ai_players/SolverPlayer.h"
+#include "headers/ai_players/MCTSPlayer.h"
 
 using namespace std;
 
 int main()
 {
-    GameManager manager(make_unique<ConnectFour>(6, 7));
+    GameManager manager(makeConnectFour(6, 7));
+    // GameManager manager(make_unique<ConnectFour>(6, 7));
+    // GameManager manager(make_unique<BitboardConnectFour>(6, 7));
+
+    // BackendTester(6, 7).runRandomGames(1000);
+
+    // do 6 ruchów: około godziny pracy jednego rdzenia, na wszystkich rdzeniach
+    // BookGenerator(6, 7, 6).generate("opening_book.bin");
 
     // manager.playSingleGame();
 
@@ -26,6 +40,37 @@ int main()
     manager.setPlayer2AI(make_unique<AlphaBetaPlayer>(7));
     manager.playSingleGame();
 
+    // manager.setPlayer2AI(make_unique<AlphaBetaPlayer>(
+    //     SearchLimits(42, chrono::milliseconds(500))));
+    // manager.playSingleGame();
+
+    // auto endgamePlayer = make_unique<AlphaBetaPlayer>(
+    //     SearchLimits(42, chrono::milliseconds(500)));
+    // endgamePlayer->setEndgameThreshold(16);
+    // manager.setPlayer2AI(move(endgamePlayer));
+    // manager.playSingleGame();
+
+    // auto smpPlayer = make_unique<AlphaBetaPlayer>(
+    //     SearchLimits(42, chrono::milliseconds(500)), 16, thread::hardware_concurrency());
+    // smpPlayer->setSpeedupBenchmark(true);
+    // manager.setPlayer2AI(move(smpPlayer));
+    // manager.playSingleGame();
+
+    // auto bookPlayer = make_unique<AlphaBetaPlayer>(9);
+    // bookPlayer->setOpeningBook(make_shared<OpeningBook>("opening_book.bin"));
+    // manager.setPlayer2AI(move(bookPlayer));
+    // manager.playSingleGame();
+
+    // manager.setPlayer2AI(make_unique<YBWPlayer>(9, 16, 4));
+    // manager.playSingleGame();
+
+    // manager.setPlayer2AI(make_unique<SolverPlayer>(chrono::milliseconds(1000)));
+    // manager.playSingleGame();
+
+    // manager.setPlayer2AI(make_unique<MCTSPlayer>(
+    //     SearchLimits(0, chrono::milliseconds(500)), thread::hardware_concurrency()));
+    // manager.playSingleGame();
+
     // manager.setBothAI(make_unique<GreedyPlayer>(),
     //                   make_unique<MinimaxPlayer>(9));
     // manager.playMultipleGames(1);